@@ -0,0 +1,550 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../common/bench.h"
+#include "../common/days.h"
+#include "../common/instrument_heap.h"
+#include "../common/runner.h"
+
+/**
+ * Benchmark harness
+ *
+ * Runs each day's binary in its --bench mode and reports min, median and
+ * p99 wall time for parsing and for each part, as a table on stdout and
+ * optionally as JSON.
+ *
+ *     main [--days 1,7,11] [--part 1|2] [--reps N] [--warmup N]
+ *          [--input input.txt] [--input-dir DIR] [--root DIR]
+ *          [--bin-dir DIR] [--compare DIR] [--json FILE] [--counters]
+ *          [--in-process]
+ *
+ * Day binaries are looked up as <root>/dayNN/main, or <bin-dir>/dayNN when
+ * --bin-dir is given. Inputs are read from <root>/dayNN/<input>, or from
+ * <input-dir>/dayNN.txt, which is how 'make synthetic' lays them out.
+ *
+ * --in-process benchmarks the days linked into the harness itself (see
+ * common/days.h) instead of running their binaries, so the samples come
+ * straight from the runner with no process to start and no output to
+ * read back. They are measured the same way either way.
+ *
+ * --compare benchmarks the binaries in a second build directory as the
+ * baseline and adds the per-day speedup of the first over it.
+ *
+ * --counters also reads hardware counters (cycles, instructions, branch,
+ * cache and TLB misses) around every phase and adds a table of their
+ * medians, with instructions per cycle. Where the kernel or the machine
+ * doesn't provide them, as in most VMs and containers, the harness says
+ * which are missing and reports times as usual.
+ */
+
+struct options {
+    std::vector<int> days;
+    int part = 0;
+    int reps = 20;
+    int warmup = 3;
+    std::string input = "input.txt";
+    std::string inputDir;
+    std::string root = ".";
+    std::string binDir;
+    std::string compareDir;
+    std::string json;
+    bool counters = false;
+    bool inProcess = false;
+};
+
+struct result {
+    std::string day;
+    std::string phase;
+    int reps;
+    aoc::Stats stats;
+};
+
+/**
+ * Median of one hardware counter over one phase's runs
+ */
+struct count {
+    std::string day;
+    std::string phase;
+    std::string counter;
+    int64_t median;
+};
+
+/**
+ * declarations
+ */
+bool parseOptions(int argc, char** argv, options& opts);
+bool benchDay(const options& opts, const std::string& binDir, int day,
+              std::vector<result>& results, std::vector<count>* counts,
+              std::set<std::string>& notes);
+bool benchInProcess(const options& opts, int day, std::vector<result>& results,
+                    std::vector<count>* counts, std::set<std::string>& notes);
+void printTable(const std::vector<result>& results);
+void printCounters(const std::vector<count>& counts,
+                   const std::set<std::string>& notes);
+void printSpeedups(const std::vector<result>& baseline,
+                   const std::vector<result>& results);
+void writeJson(std::ostream& out, const options& opts,
+               const std::vector<result>& results,
+               const std::vector<result>& baseline,
+               const std::vector<count>& counts);
+
+/**
+ * main function
+ */
+int main(int argc, char** argv) {
+    options opts;
+    if (!parseOptions(argc, argv, opts)) return 1;
+
+    std::vector<result> results;
+    std::vector<result> baseline;
+    std::vector<count> counts;
+    std::set<std::string> notes;
+    bool ok = true;
+    for (int day : opts.days) {
+        std::vector<count>* dayCounts = opts.counters ? &counts : nullptr;
+        ok = (opts.inProcess
+                  ? benchInProcess(opts, day, results, dayCounts, notes)
+                  : benchDay(opts, opts.binDir, day, results, dayCounts,
+                             notes)) &&
+             ok;
+        if (!opts.compareDir.empty())
+            ok = benchDay(opts, opts.compareDir, day, baseline, nullptr,
+                          notes) &&
+                 ok;
+    }
+
+    printTable(results);
+    if (opts.counters) printCounters(counts, notes);
+    if (!opts.compareDir.empty()) printSpeedups(baseline, results);
+
+    if (opts.json == "-") {
+        writeJson(std::cout, opts, results, baseline, counts);
+    } else if (!opts.json.empty()) {
+        std::ofstream file(opts.json);
+        if (!file) {
+            std::cout << "Couldn't write " << opts.json << "\n";
+            return 1;
+        }
+        writeJson(file, opts, results, baseline, counts);
+    }
+
+    return ok ? 0 : 1;
+}
+
+/**
+ * Options
+ */
+bool parseDays(const char* list, std::vector<int>& days) {
+    days.clear();
+    const char* at = list;
+    while (*at != '\0') {
+        char* end = nullptr;
+        long day = std::strtol(at, &end, 10);
+        if (end == at || day < 1 || day > 25) return false;
+        days.push_back(static_cast<int>(day));
+
+        at = end;
+        if (*at == ',') at++;
+        else if (*at != '\0')
+            return false;
+    }
+    return !days.empty();
+}
+
+bool parseOptions(int argc, char** argv, options& opts) {
+    for (int day = 1; day <= 11; day++) opts.days.push_back(day);
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--counters") {
+            opts.counters = true;
+            continue;
+        }
+        if (arg == "--in-process") {
+            opts.inProcess = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            std::cout << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--days") {
+            if (!parseDays(value, opts.days)) {
+                std::cout << "Bad day list: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--part") {
+            opts.part = std::atoi(value);
+            if (opts.part < 1 || opts.part > 2) {
+                std::cout << "Part must be 1 or 2\n";
+                return false;
+            }
+        } else if (arg == "--reps") {
+            opts.reps = std::atoi(value);
+            if (opts.reps < 1) {
+                std::cout << "Need at least one rep\n";
+                return false;
+            }
+        } else if (arg == "--warmup") {
+            opts.warmup = std::atoi(value);
+        } else if (arg == "--input") {
+            opts.input = value;
+        } else if (arg == "--input-dir") {
+            opts.inputDir = value;
+        } else if (arg == "--root") {
+            opts.root = value;
+        } else if (arg == "--bin-dir") {
+            opts.binDir = value;
+        } else if (arg == "--compare") {
+            opts.compareDir = value;
+        } else if (arg == "--json") {
+            opts.json = value;
+        } else {
+            std::cout << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Running
+ */
+std::string dayName(int day) {
+    std::string name = "day";
+    if (day < 10) name += "0";
+    return name + std::to_string(day);
+}
+
+std::string inputFor(const options& opts, const std::string& name) {
+    return opts.inputDir.empty() ? opts.root + "/" + name + "/" + opts.input
+                                 : opts.inputDir + "/" + name + ".txt";
+}
+
+/**
+ * Per-run sum of every phase. Samples line up by run, so this is the time
+ * one full solve of the day took.
+ */
+aoc::Samples totalSamples(const std::vector<aoc::Samples>& phases) {
+    aoc::Samples total(phases.front().size(), 0);
+    for (const auto& phase : phases)
+        for (size_t run = 0; run < total.size() && run < phase.size(); run++)
+            total[run] += phase[run];
+    return total;
+}
+
+/**
+ * Run one day's benchmark. Counter lines go to counts when it's given, and
+ * the day binary's "#" notes about missing counters go to notes.
+ */
+bool benchDay(const options& opts, const std::string& binDir, int day,
+              std::vector<result>& results, std::vector<count>* counts,
+              std::set<std::string>& notes) {
+    std::string name = dayName(day);
+    std::string binary = binDir.empty() ? opts.root + "/" + name + "/main"
+                                        : binDir + "/" + name;
+    std::string input = inputFor(opts, name);
+
+    std::string command = "'" + binary + "' '" + input + "' --bench " +
+                          std::to_string(opts.reps) + " --warmup " +
+                          std::to_string(opts.warmup);
+    if (opts.part != 0) command += " --part " + std::to_string(opts.part);
+    if (counts != nullptr) command += " --counters";
+
+    FILE* pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) {
+        std::cout << name << ": couldn't run " << binary << "\n";
+        return false;
+    }
+
+    std::string output;
+    char buffer[4096];
+    while (std::fgets(buffer, sizeof(buffer), pipe) != nullptr)
+        output += buffer;
+
+    int status = pclose(pipe);
+    if (status != 0) {
+        std::cout << name << ": " << binary << " failed";
+        if (WIFEXITED(status)) std::cout << " with " << WEXITSTATUS(status);
+        std::cout << "\n" << output;
+        return false;
+    }
+
+    std::vector<aoc::Samples> phases;
+    std::string line;
+    std::string phase;
+    aoc::Samples samples;
+    size_t start = 0;
+    while (start < output.size()) {
+        size_t end = output.find('\n', start);
+        if (end == std::string::npos) end = output.size();
+        line = output.substr(start, end - start);
+        start = end + 1;
+
+        if (line.compare(0, 2, "# ") == 0) notes.insert(line.substr(2));
+        if (!aoc::readSamples(line, phase, samples)) continue;
+
+        size_t colon = phase.find(':');
+        if (colon != std::string::npos) {
+            if (counts != nullptr)
+                counts->push_back({name, phase.substr(0, colon),
+                                   phase.substr(colon + 1),
+                                   aoc::summarize(samples).median});
+            continue;
+        }
+        results.push_back({name, phase, static_cast<int>(samples.size()),
+                           aoc::summarize(samples)});
+        phases.push_back(samples);
+    }
+
+    if (phases.empty()) {
+        std::cout << name << ": no samples from " << binary << "\n";
+        return false;
+    }
+
+    aoc::Samples total = totalSamples(phases);
+    results.push_back(
+        {name, "total", static_cast<int>(total.size()), aoc::summarize(total)});
+    return true;
+}
+
+/**
+ * Run one day's benchmark on the solver linked into the harness, taking
+ * the samples from the runner directly
+ */
+bool benchInProcess(const options& opts, int day, std::vector<result>& results,
+                    std::vector<count>* counts, std::set<std::string>& notes) {
+    std::string name = dayName(day);
+    const aoc::Solver* solver = aoc::findSolver(day);
+    if (solver == nullptr) {
+        std::cout << name << ": not linked into the harness\n";
+        return false;
+    }
+
+    aoc::Options run;
+    run.inputFile = inputFor(opts, name);
+    run.part = opts.part;
+    run.benchReps = opts.reps;
+    run.warmup = opts.warmup;
+    run.counters = counts != nullptr;
+    if (::access(run.inputFile.c_str(), R_OK) != 0) {
+        std::cout << name << ": couldn't read " << run.inputFile << "\n";
+        return false;
+    }
+    aoc::BenchRun bench = aoc::benchSolver(*solver, run);
+
+    if (!bench.missingCounters.empty()) {
+        std::string note = "missing counters:";
+        for (const std::string& counter : bench.missingCounters)
+            note += " " + counter;
+        notes.insert(note + " (" + bench.counterError + ")");
+    }
+
+    std::vector<aoc::Samples> phases;
+    auto addPhase = [&](const char* phase, const aoc::Samples& samples,
+                        const std::vector<aoc::Samples>& phaseCounts) {
+        if (samples.empty()) return;
+        results.push_back({name, phase, static_cast<int>(samples.size()),
+                           aoc::summarize(samples)});
+        phases.push_back(samples);
+        if (counts == nullptr) return;
+        for (size_t i = 0; i < phaseCounts.size(); i++)
+            counts->push_back({name, phase, bench.counters[i],
+                               aoc::summarize(phaseCounts[i]).median});
+    };
+    addPhase("parse", bench.parse, bench.parseCounts);
+    addPhase("part1", bench.part1, bench.part1Counts);
+    addPhase("part2", bench.part2, bench.part2Counts);
+
+    aoc::Samples total = totalSamples(phases);
+    results.push_back(
+        {name, "total", static_cast<int>(total.size()), aoc::summarize(total)});
+    return true;
+}
+
+/**
+ * Reporting
+ */
+double toMicros(int64_t ns) { return ns / 1000.0; }
+
+void printTable(const std::vector<result>& results) {
+    std::cout << std::left << std::setw(8) << "day" << std::setw(8) << "phase"
+              << std::right << std::setw(14) << "min (us)" << std::setw(14)
+              << "median (us)" << std::setw(14) << "p99 (us)" << "\n";
+
+    std::cout << std::fixed << std::setprecision(1);
+    const result* slowest = nullptr;
+    for (const auto& res : results) {
+        std::cout << std::left << std::setw(8) << res.day << std::setw(8)
+                  << res.phase << std::right << std::setw(14)
+                  << toMicros(res.stats.min) << std::setw(14)
+                  << toMicros(res.stats.median) << std::setw(14)
+                  << toMicros(res.stats.p99) << "\n";
+
+        if (res.phase == "total" &&
+            (slowest == nullptr || res.stats.median > slowest->stats.median))
+            slowest = &res;
+    }
+
+    if (slowest != nullptr)
+        std::cout << "\nSlowest: " << slowest->day << " ("
+                  << toMicros(slowest->stats.median) << " us median)\n";
+    std::cout << std::defaultfloat;
+}
+
+/**
+ * One row per day and phase, one column per counter that any day reported
+ */
+void printCounters(const std::vector<count>& counts,
+                   const std::set<std::string>& notes) {
+    std::cout << "\n";
+    for (const std::string& note : notes) std::cout << note << "\n";
+    if (counts.empty()) {
+        std::cout << "No hardware counters available, check "
+                     "/proc/sys/kernel/perf_event_paranoid\n";
+        return;
+    }
+
+    std::vector<std::string> columns;
+    for (const count& c : counts) {
+        bool seen = false;
+        for (const std::string& column : columns) seen |= column == c.counter;
+        if (!seen) columns.push_back(c.counter);
+    }
+
+    std::cout << std::left << std::setw(8) << "day" << std::setw(8) << "phase"
+              << std::right;
+    for (const std::string& column : columns)
+        std::cout << std::setw(15) << column;
+    std::cout << std::setw(8) << "IPC" << "\n";
+
+    std::cout << std::fixed << std::setprecision(2);
+    size_t i = 0;
+    while (i < counts.size()) {
+        // a day's counters for one phase are next to each other
+        const count& first = counts[i];
+        size_t end = i;
+        while (end < counts.size() && counts[end].day == first.day &&
+               counts[end].phase == first.phase)
+            end++;
+
+        std::cout << std::left << std::setw(8) << first.day << std::setw(8)
+                  << first.phase << std::right;
+
+        int64_t cycles = 0;
+        int64_t instructions = 0;
+        for (const std::string& column : columns) {
+            const count* found = nullptr;
+            for (size_t j = i; j < end; j++)
+                if (counts[j].counter == column) found = &counts[j];
+
+            if (found == nullptr) {
+                std::cout << std::setw(15) << "-";
+                continue;
+            }
+            std::cout << std::setw(15) << found->median;
+            if (column == "cycles") cycles = found->median;
+            if (column == "instructions") instructions = found->median;
+        }
+        if (cycles > 0 && instructions > 0)
+            std::cout << std::setw(8)
+                      << static_cast<double>(instructions) / cycles;
+        else
+            std::cout << std::setw(8) << "-";
+        std::cout << "\n";
+        i = end;
+    }
+    std::cout << std::defaultfloat;
+}
+
+/**
+ * Median total of the baseline over median total of this build, per day
+ */
+void printSpeedups(const std::vector<result>& baseline,
+                   const std::vector<result>& results) {
+    std::cout << "\n"
+              << std::left << std::setw(8) << "day" << std::right
+              << std::setw(16) << "baseline (us)" << std::setw(14)
+              << "this (us)" << std::setw(10) << "speedup" << "\n";
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& res : results) {
+        if (res.phase != "total") continue;
+        for (const auto& base : baseline) {
+            if (base.day != res.day || base.phase != "total") continue;
+
+            double speedup = res.stats.median > 0
+                                 ? static_cast<double>(base.stats.median) /
+                                       res.stats.median
+                                 : 0.0;
+            std::cout << std::left << std::setw(8) << res.day << std::right
+                      << std::setw(16) << toMicros(base.stats.median)
+                      << std::setw(14) << toMicros(res.stats.median)
+                      << std::setw(9) << std::setprecision(2) << speedup
+                      << "x" << std::setprecision(1) << "\n";
+        }
+    }
+    std::cout << std::defaultfloat;
+}
+
+void writeResults(std::ostream& out, const std::vector<result>& results) {
+    out << "[";
+    for (size_t i = 0; i < results.size(); i++) {
+        const result& res = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"day\": \"" << res.day << "\", \"phase\": \""
+            << res.phase << "\", \"reps\": " << res.reps
+            << ", \"min_ns\": " << res.stats.min
+            << ", \"median_ns\": " << res.stats.median
+            << ", \"p99_ns\": " << res.stats.p99 << "}";
+    }
+    out << "\n  ]";
+}
+
+void writeCounts(std::ostream& out, const std::vector<count>& counts) {
+    out << "[";
+    for (size_t i = 0; i < counts.size(); i++) {
+        const count& c = counts[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"day\": \"" << c.day << "\", \"phase\": \"" << c.phase
+            << "\", \"counter\": \"" << c.counter
+            << "\", \"median\": " << c.median << "}";
+    }
+    out << "\n  ]";
+}
+
+void writeJson(std::ostream& out, const options& opts,
+               const std::vector<result>& results,
+               const std::vector<result>& baseline,
+               const std::vector<count>& counts) {
+    out << "{\n";
+    out << "  \"reps\": " << opts.reps << ",\n";
+    out << "  \"warmup\": " << opts.warmup << ",\n";
+    std::string input =
+        opts.inputDir.empty() ? opts.input : opts.inputDir + "/";
+    out << "  \"input\": \"" << input << "\",\n";
+    out << "  \"results\": ";
+    writeResults(out, results);
+    if (!opts.compareDir.empty()) {
+        out << ",\n  \"baseline\": ";
+        writeResults(out, baseline);
+    }
+    if (opts.counters) {
+        out << ",\n  \"counters\": ";
+        writeCounts(out, counts);
+    }
+    out << "\n}\n";
+}
@@ -0,0 +1,380 @@
+#include <fcntl.h>
+#include <glob.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/bench.h"
+
+/**
+ * Regression gate
+ *
+ * Runs every day on each of its bundled inputs (dayNN/...input...txt), checks
+ * the output against the golden answers and, for the real puzzle input,
+ * checks wall time and peak memory against the day's budget. Exits non-zero
+ * if anything is wrong, so it can gate a change.
+ *
+ *     main [--days 1,7,11] [--root DIR] [--bin-dir DIR] [--golden FILE]
+ *          [--budgets FILE] [--runs N] [--no-budgets] [--update]
+ *
+ * Golden answers live in check/golden.txt as each input's exact output
+ * under a "== dayNN/<input>" header, the same layout --batch prints.
+ * --update rewrites that file from the current binaries; review the diff
+ * before committing it.
+ *
+ * Budgets live in check/budgets.txt, one line per day:
+ *
+ *     <day> <time ms> <peak RSS KB>
+ *
+ * They're set for the release build, which is what 'make check' runs.
+ * Time is the fastest of --runs runs of the whole process, so start-up and
+ * parsing count, and memory is the peak RSS the kernel reports for it.
+ */
+
+struct options {
+    std::vector<int> days;
+    std::string root = ".";
+    std::string binDir;
+    std::string golden;
+    std::string budgets;
+    int runs = 3;
+    bool checkBudgets = true;
+    bool update = false;
+};
+
+struct budget {
+    double timeMs = 0;
+    long rssKb = 0;
+};
+
+struct run {
+    bool ok = false;
+    std::string output;
+    int64_t wallNs = 0;
+    long rssKb = 0;
+};
+
+/**
+ * declarations
+ */
+bool parseOptions(int argc, char** argv, options& opts);
+std::vector<std::string> inputsFor(const options& opts, int day);
+run runDay(const std::string& binary, const std::string& input);
+bool readGolden(const std::string& path,
+                std::map<std::string, std::string>& golden);
+bool readBudgets(const std::string& path, std::map<std::string, budget>& out);
+std::string dayName(int day);
+
+/**
+ * main function
+ */
+int main(int argc, char** argv) {
+    options opts;
+    if (!parseOptions(argc, argv, opts)) return 1;
+
+    std::map<std::string, std::string> golden;
+    std::map<std::string, budget> budgets;
+    if (!opts.update && !readGolden(opts.golden, golden)) return 1;
+    if (opts.checkBudgets && !opts.update &&
+        !readBudgets(opts.budgets, budgets))
+        return 1;
+
+    std::ostringstream updated;
+    int failures = 0;
+    std::cout << std::fixed << std::setprecision(1);
+    for (int day : opts.days) {
+        std::string name = dayName(day);
+        std::string binary = opts.binDir.empty()
+                                 ? opts.root + "/" + name + "/main"
+                                 : opts.binDir + "/" + name;
+
+        for (const std::string& input : inputsFor(opts, day)) {
+            std::string path = opts.root + "/" + input;
+            bool real = input == name + "/input.txt";
+            bool timed = real && opts.checkBudgets && !opts.update;
+
+            run best = runDay(binary, path);
+            for (int i = 1; timed && best.ok && i < opts.runs; i++) {
+                run again = runDay(binary, path);
+                if (again.wallNs < best.wallNs) best.wallNs = again.wallNs;
+                if (again.rssKb > best.rssKb) best.rssKb = again.rssKb;
+            }
+
+            std::cout << std::left << std::setw(32) << input << std::right;
+            if (!best.ok) {
+                std::cout << "FAILED to run\n" << best.output;
+                failures++;
+                continue;
+            }
+
+            if (opts.update) {
+                updated << "== " << input << "\n" << best.output;
+                std::cout << "recorded\n";
+                continue;
+            }
+
+            auto expected = golden.find(input);
+            if (expected == golden.end()) {
+                std::cout << "no golden answer\n";
+                failures++;
+                continue;
+            }
+            if (expected->second != best.output) {
+                std::cout << "WRONG ANSWER\n"
+                          << "  expected:\n" << expected->second
+                          << "  got:\n" << best.output;
+                failures++;
+                continue;
+            }
+            std::cout << "ok";
+
+            if (timed) {
+                double ms = best.wallNs / 1e6;
+                std::cout << std::setw(10) << ms << " ms" << std::setw(10)
+                          << best.rssKb << " KB";
+
+                auto limit = budgets.find(name);
+                if (limit == budgets.end()) {
+                    std::cout << "  no budget";
+                    failures++;
+                } else {
+                    if (ms > limit->second.timeMs) {
+                        std::cout << "  OVER " << limit->second.timeMs
+                                  << " ms";
+                        failures++;
+                    }
+                    if (best.rssKb > limit->second.rssKb) {
+                        std::cout << "  OVER " << limit->second.rssKb
+                                  << " KB";
+                        failures++;
+                    }
+                }
+            }
+            std::cout << "\n";
+        }
+    }
+
+    if (opts.update) {
+        std::ofstream file(opts.golden);
+        if (!file) {
+            std::cout << "Couldn't write " << opts.golden << "\n";
+            return 1;
+        }
+        file << updated.str();
+        std::cout << "\nWrote " << opts.golden << "\n";
+    } else if (failures > 0) {
+        std::cout << "\n" << failures << " check(s) failed\n";
+    } else {
+        std::cout << "\nAll checks passed\n";
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+/**
+ * Options
+ */
+bool parseDays(const char* list, std::vector<int>& days) {
+    days.clear();
+    const char* at = list;
+    while (*at != '\0') {
+        char* end = nullptr;
+        long day = std::strtol(at, &end, 10);
+        if (end == at || day < 1 || day > 25) return false;
+        days.push_back(static_cast<int>(day));
+
+        at = end;
+        if (*at == ',') at++;
+        else if (*at != '\0')
+            return false;
+    }
+    return !days.empty();
+}
+
+bool parseOptions(int argc, char** argv, options& opts) {
+    for (int day = 1; day <= 11; day++) opts.days.push_back(day);
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--update") {
+            opts.update = true;
+            continue;
+        } else if (arg == "--no-budgets") {
+            opts.checkBudgets = false;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            std::cout << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--days") {
+            if (!parseDays(value, opts.days)) {
+                std::cout << "Bad day list: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--root") {
+            opts.root = value;
+        } else if (arg == "--bin-dir") {
+            opts.binDir = value;
+        } else if (arg == "--golden") {
+            opts.golden = value;
+        } else if (arg == "--budgets") {
+            opts.budgets = value;
+        } else if (arg == "--runs") {
+            opts.runs = std::atoi(value);
+            if (opts.runs < 1) {
+                std::cout << "Need at least one run\n";
+                return false;
+            }
+        } else {
+            std::cout << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+
+    if (opts.golden.empty()) opts.golden = opts.root + "/check/golden.txt";
+    if (opts.budgets.empty()) opts.budgets = opts.root + "/check/budgets.txt";
+    return true;
+}
+
+/**
+ * Inputs
+ */
+std::string dayName(int day) {
+    std::string name = "day";
+    if (day < 10) name += "0";
+    return name + std::to_string(day);
+}
+
+/**
+ * The day's bundled inputs, relative to the root
+ */
+std::vector<std::string> inputsFor(const options& opts, int day) {
+    std::string name = dayName(day);
+    std::string pattern = opts.root + "/" + name + "/*input*.txt";
+
+    std::vector<std::string> inputs;
+    glob_t matches;
+    if (::glob(pattern.c_str(), 0, nullptr, &matches) == 0) {
+        for (size_t i = 0; i < matches.gl_pathc; i++) {
+            std::string path = matches.gl_pathv[i];
+            inputs.push_back(name + path.substr(path.rfind('/')));
+        }
+    }
+    globfree(&matches);
+    return inputs;
+}
+
+bool readGolden(const std::string& path,
+                std::map<std::string, std::string>& golden) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cout << "Couldn't read " << path << ", run with --update\n";
+        return false;
+    }
+
+    std::string line;
+    std::string* current = nullptr;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 3, "== ") == 0) {
+            current = &golden[line.substr(3)];
+        } else if (current != nullptr) {
+            *current += line + "\n";
+        }
+    }
+    return true;
+}
+
+bool readBudgets(const std::string& path, std::map<std::string, budget>& out) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cout << "Couldn't read " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line.front() == '#') continue;
+
+        std::istringstream fields(line);
+        std::string day;
+        budget limit;
+        if (!(fields >> day >> limit.timeMs >> limit.rssKb)) {
+            std::cout << "Bad budget line in " << path << ": " << line
+                      << "\n";
+            return false;
+        }
+        out[day] = limit;
+    }
+    return true;
+}
+
+/**
+ * Running
+ */
+
+/**
+ * Run one day on one input, capturing its stdout and stderr. wait4() gives
+ * the peak RSS of just that child.
+ */
+run runDay(const std::string& binary, const std::string& input) {
+    run result;
+
+    int out[2];
+    if (pipe(out) != 0) {
+        result.output = std::string("pipe: ") + std::strerror(errno) + "\n";
+        return result;
+    }
+
+    aoc::Clock::time_point start = aoc::Clock::now();
+    pid_t child = fork();
+    if (child == 0) {
+        dup2(out[1], STDOUT_FILENO);
+        dup2(out[1], STDERR_FILENO);
+        close(out[0]);
+        close(out[1]);
+        execl(binary.c_str(), binary.c_str(), input.c_str(),
+              static_cast<char*>(nullptr));
+        std::cerr << "Couldn't run " << binary << "\n";
+        _exit(127);
+    }
+    close(out[1]);
+    if (child < 0) {
+        close(out[0]);
+        result.output = std::string("fork: ") + std::strerror(errno) + "\n";
+        return result;
+    }
+
+    char buffer[4096];
+    ssize_t got;
+    while ((got = read(out[0], buffer, sizeof(buffer))) != 0) {
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        result.output.append(buffer, got);
+    }
+    close(out[0]);
+
+    int status = 0;
+    struct rusage usage {};
+    while (wait4(child, &status, 0, &usage) < 0 && errno == EINTR)
+        ;
+    result.wallNs = aoc::elapsedNs(start, aoc::Clock::now());
+    result.rssKb = usage.ru_maxrss;
+    result.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    return result;
+}
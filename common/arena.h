@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace aoc {
+    /**
+     * Memory for one run's parsed model. Everything is bumped out of a few
+     * large blocks and given back all at once when the run is over, so
+     * building a model full of small nodes and vectors costs next to nothing
+     * in malloc and free.
+     *
+     * The runner gives every run its own arena and makes it the current one
+     * on that thread; parsers reach it through arena() and hand it to the
+     * std::pmr containers they build:
+     *
+     *     std::pmr::vector<long> values(aoc::arena());
+     *
+     * Nested pmr containers pick the arena up from their parent. Outside a
+     * run, arena() is plain new and delete.
+     *
+     * Freed memory isn't reused until the run ends, so this is for data
+     * that is built once and kept. Temporaries created and thrown away in a
+     * solver's loop belong on the ordinary heap.
+     */
+    class Arena {
+    public:
+        explicit Arena(size_t firstBlock = 64 * 1024)
+            : _first(new std::byte[firstBlock]),
+              _resource(_first.get(), firstBlock) {}
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        std::pmr::memory_resource* resource() { return &_resource; }
+
+        /**
+         * Give back everything and start over from the first block. Nothing
+         * allocated from the arena may be used afterwards.
+         */
+        void reset() { _resource.release(); }
+
+    private:
+        std::unique_ptr<std::byte[]> _first;
+        std::pmr::monotonic_buffer_resource _resource;
+    };
+
+    namespace detail {
+        inline std::pmr::memory_resource*& currentArena() {
+            thread_local std::pmr::memory_resource* current =
+                std::pmr::new_delete_resource();
+            return current;
+        }
+    }  // namespace detail
+
+    /**
+     * The arena of the run on this thread
+     */
+    inline std::pmr::memory_resource* arena() {
+        return detail::currentArena();
+    }
+
+    /**
+     * Make arena the current one on this thread for a scope
+     */
+    class ArenaScope {
+    public:
+        explicit ArenaScope(Arena& arena) : _previous(detail::currentArena()) {
+            detail::currentArena() = arena.resource();
+        }
+        ~ArenaScope() { detail::currentArena() = _previous; }
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+    private:
+        std::pmr::memory_resource* _previous;
+    };
+}  // namespace aoc
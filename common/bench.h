@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Wall time samples for one phase, in nanoseconds
+     */
+    using Samples = std::vector<int64_t>;
+
+    inline int64_t elapsedNs(Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from)
+            .count();
+    }
+
+    struct Stats {
+        int64_t min = 0;
+        int64_t median = 0;
+        int64_t p99 = 0;
+    };
+
+    /**
+     * Percentiles use the nearest-rank method, so every reported value is a
+     * time that was actually measured.
+     */
+    inline Stats summarize(Samples samples) {
+        Stats stats;
+        if (samples.empty()) return stats;
+
+        std::sort(samples.begin(), samples.end());
+        size_t count = samples.size();
+
+        stats.min = samples.front();
+        stats.median = samples[(count - 1) / 2];
+        stats.p99 = samples[(count * 99 + 99) / 100 - 1];
+        return stats;
+    }
+
+    /**
+     * Samples travel from a day binary to the harness one phase per line:
+     *
+     *     <phase> <ns> <ns> ...
+     */
+    inline void writeSamples(std::ostream& out, std::string_view phase,
+                             const Samples& samples) {
+        out << phase;
+        for (int64_t ns : samples) out << " " << ns;
+        out << "\n";
+    }
+
+    inline bool readSamples(const std::string& line, std::string& phase,
+                            Samples& samples) {
+        std::istringstream in(line);
+        if (!(in >> phase)) return false;
+
+        samples.clear();
+        int64_t ns;
+        while (in >> ns) samples.push_back(ns);
+        return !samples.empty();
+    }
+}  // namespace aoc
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cctype>
+#include <iterator>
+#include <string>
+
+#include "../day01/day.h"
+#include "../day02/day.h"
+#include "../day03/day.h"
+#include "../day04/day.h"
+#include "../day05/day.h"
+#include "../day06/day.h"
+#include "../day07/day.h"
+#include "../day08/day.h"
+#include "../day09/day.h"
+#include "../day10/day.h"
+#include "../day11/day.h"
+#include "solver.h"
+
+/**
+ * Every day's solver, for the tools that solve days in-process (solve/,
+ * serve/, bench/ --in-process and fuzz/).
+ *
+ * Each day is a header, dayNN/day.h, declaring dayNN::solver(), and a
+ * translation unit, dayNN/day.cpp, defining it along with everything else
+ * the day needs under namespace dayNN. The Makefile compiles every day.cpp
+ * once and links the objects into both the day's own program and these
+ * tools. A new day adds its header here and its solver to findSolver().
+ */
+
+namespace aoc {
+    /**
+     * The solver for day, or nullptr for a day that isn't solved yet
+     */
+    inline const Solver* findSolver(int day) {
+        static const Solver* const solvers[] = {
+            &day01::solver(), &day02::solver(), &day03::solver(),
+            &day04::solver(), &day05::solver(), &day06::solver(),
+            &day07::solver(), &day08::solver(), &day09::solver(),
+            &day10::solver(), &day11::solver(),
+        };
+        if (day < 1 || day > static_cast<int>(std::size(solvers)))
+            return nullptr;
+        return solvers[day - 1];
+    }
+
+    /**
+     * The solver a day's fast path replaced, which the day keeps to check
+     * its answers against (see fuzz/), or nullptr for a day without one
+     */
+    inline const Solver* findReference(int day) {
+        switch (day) {
+            case 5: return &day05::reference();
+            case 6: return &day06::reference();
+            case 10: return &day10::reference();
+            case 11: return &day11::reference();
+        }
+        return nullptr;
+    }
+
+    /**
+     * The solver for an input file, by the first "dayNN" in its path, as in
+     * day07/input.txt or build/synthetic/day07.txt
+     */
+    inline const Solver* solverForPath(const std::string& path) {
+        for (size_t at = path.find("day"); at != std::string::npos;
+             at = path.find("day", at + 1)) {
+            if (at + 5 > path.size() || !std::isdigit(path[at + 3]) ||
+                !std::isdigit(path[at + 4]))
+                continue;
+            return findSolver((path[at + 3] - '0') * 10 + path[at + 4] - '0');
+        }
+        return nullptr;
+    }
+}  // namespace aoc
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "arena.h"
+#include "input.h"
+
+namespace aoc {
+    /**
+     * One row or column of a Grid2D. Rows are contiguous, columns step a
+     * whole padded row at a time. Views don't own anything and are only
+     * valid for as long as the grid is.
+     */
+    template <typename T>
+    class GridLine {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_const_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+
+            iterator(T* at, std::ptrdiff_t stride) : _at(at), _stride(stride) {}
+
+            T& operator*() const { return *_at; }
+            iterator& operator++() {
+                _at += _stride;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator before = *this;
+                _at += _stride;
+                return before;
+            }
+            bool operator==(const iterator& other) const {
+                return _at == other._at;
+            }
+            bool operator!=(const iterator& other) const {
+                return _at != other._at;
+            }
+
+        private:
+            T* _at;
+            std::ptrdiff_t _stride;
+        };
+
+        GridLine(T* first, int size, std::ptrdiff_t stride)
+            : _first(first), _size(size), _stride(stride) {}
+
+        int size() const { return _size; }
+        T& operator[](int i) const { return _first[i * _stride]; }
+
+        iterator begin() const { return iterator(_first, _stride); }
+        iterator end() const {
+            return iterator(_first + _size * _stride, _stride);
+        }
+
+    private:
+        T* _first;
+        int _size;
+        std::ptrdiff_t _stride;
+    };
+
+    /**
+     * Row-major grid in one allocation, surrounded by a border of sentinel
+     * cells. Any cell up to border steps outside the grid can be read, so
+     * looking at the neighbours of an edge cell needs no bounds check as
+     * long as the sentinel is something the caller treats as empty.
+     *
+     *     aoc::Grid2D<char> grid(height, width, '.');
+     *     grid(-1, 0)          a sentinel
+     *     grid.row(3)          view of row 3, without the border
+     *     grid.column(5)       view of column 5, without the border
+     *
+     * Cells come from the run's arena unless another resource is given,
+     * since a grid is nearly always part of a parsed model. A copy has its
+     * cells on the heap, so a solver can copy a grid to scribble on.
+     *
+     * Don't instantiate with bool; std::vector<bool> can't hand out
+     * references, so use char for flags.
+     */
+    template <typename T>
+    class Grid2D {
+    public:
+        Grid2D() = default;
+
+        Grid2D(int height, int width, const T& sentinel, int border = 1,
+               std::pmr::memory_resource* resource = arena())
+            : _height(height),
+              _width(width),
+              _border(border),
+              _pitch(width + 2 * border),
+              _cells(static_cast<size_t>(height + 2 * border) * _pitch,
+                     sentinel, resource) {}
+
+        int height() const { return _height; }
+        int width() const { return _width; }
+        int border() const { return _border; }
+
+        /**
+         * Inside the grid proper, not on the border
+         */
+        bool inBounds(int row, int col) const {
+            return row >= 0 && row < _height && col >= 0 && col < _width;
+        }
+
+        T& operator()(int row, int col) { return _cells[index(row, col)]; }
+        const T& operator()(int row, int col) const {
+            return _cells[index(row, col)];
+        }
+
+        GridLine<T> row(int r) { return {&(*this)(r, 0), _width, 1}; }
+        GridLine<const T> row(int r) const {
+            return {&(*this)(r, 0), _width, 1};
+        }
+
+        GridLine<T> column(int c) { return {&(*this)(0, c), _height, _pitch}; }
+        GridLine<const T> column(int c) const {
+            return {&(*this)(0, c), _height, _pitch};
+        }
+
+    private:
+        size_t index(int row, int col) const {
+            return static_cast<size_t>(row + _border) * _pitch + col + _border;
+        }
+
+        int _height = 0;
+        int _width = 0;
+        int _border = 0;
+        int _pitch = 0;
+        std::pmr::vector<T> _cells {arena()};
+    };
+
+    /**
+     * The input as a character grid, as wide as its first line. Shorter
+     * lines are padded and longer ones cut to that width; the padding and
+     * the border are filled with sentinel.
+     */
+    inline Grid2D<char> readGrid(const Input& input, char sentinel,
+                                 int border = 1) {
+        int width = input.width();
+        Grid2D<char> grid(input.lineCount(), width, sentinel, border);
+
+        Lines lines = input.lines();
+        std::string_view line;
+        for (int row = 0; row < grid.height() && lines.next(line); row++) {
+            GridLine<char> cells = grid.row(row);
+            for (int col = 0; col < width && col < int(line.size()); col++)
+                cells[col] = line[col];
+        }
+        return grid;
+    }
+}  // namespace aoc
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "instrument.h"
+
+namespace aoc {
+    /**
+     * Cursor over the lines of a buffer. Lines are handed out as views into
+     * the buffer without the trailing '\n', the same way std::getline splits
+     * them, so a final newline doesn't produce an extra empty line.
+     */
+    class Lines {
+    public:
+        explicit Lines(std::string_view data) : _rest(data) {}
+
+        bool next(std::string_view& line) {
+            if (_rest.empty()) return false;
+
+            AOC_COUNT("lines read", 1);
+            const void* found = std::memchr(_rest.data(), '\n', _rest.size());
+            if (found == nullptr) {
+                AOC_COUNT("bytes read", _rest.size());
+                line = _rest;
+                _rest = {};
+                return true;
+            }
+
+            size_t length = static_cast<const char*>(found) - _rest.data();
+            AOC_COUNT("bytes read", length + 1);
+            line = _rest.substr(0, length);
+            _rest.remove_prefix(length + 1);
+            return true;
+        }
+
+    private:
+        std::string_view _rest;
+    };
+
+    /**
+     * An input that couldn't be opened, read or mapped. run() prints it and
+     * exits; the daemon sends it back to the one client that asked.
+     */
+    class InputError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * Open an input for reading, where "-" is stdin
+     */
+    inline int openInput(const std::string& filePath) {
+        if (filePath == "-") return STDIN_FILENO;
+
+        int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd < 0) throw InputError("Coudn't find input file");
+        return fd;
+    }
+
+    /**
+     * read() that retries when interrupted, throws on a real error
+     */
+    inline size_t readSome(int fd, char* buffer, size_t size) {
+        while (true) {
+            ssize_t count = ::read(fd, buffer, size);
+            if (count >= 0) return count;
+            if (errno != EINTR) throw InputError("Coudn't read input file");
+        }
+    }
+
+    /**
+     * Puzzle input held in memory once. Regular files are mapped; stdin,
+     * pipes and FIFOs can't be, so they are read to the end into a buffer
+     * instead. Everything handed out is a view into that memory, so it stays
+     * valid for as long as the Input does.
+     */
+    class Input {
+    public:
+        explicit Input(const std::string& filePath) {
+            int fd = openInput(filePath);
+            try {
+                load(fd);
+            } catch (...) {
+                if (fd != STDIN_FILENO) ::close(fd);
+                throw;
+            }
+            if (fd != STDIN_FILENO) ::close(fd);
+        }
+
+        /**
+         * Input that is already in memory, like a payload sent to --serve.
+         * Nothing is copied, so contents has to outlive the Input.
+         */
+        static Input borrow(std::string_view contents) {
+            return Input(contents.data(), contents.size());
+        }
+
+        ~Input() {
+            if (_mapped) ::munmap(const_cast<char*>(_data), _size);
+        }
+
+        Input(const Input&) = delete;
+        Input& operator=(const Input&) = delete;
+
+        std::string_view data() const { return {_data, _size}; }
+
+        Lines lines() const { return Lines(data()); }
+
+        /**
+         * Number of lines, counted the same way Lines hands them out
+         */
+        size_t lineCount() const {
+            std::string_view all = data();
+            if (all.empty()) return 0;
+
+            size_t count = 0;
+            const char* at = all.data();
+            const char* end = at + all.size();
+            while (at < end) {
+                const void* found = std::memchr(at, '\n', end - at);
+                if (found == nullptr) break;
+                count++;
+                at = static_cast<const char*>(found) + 1;
+            }
+            if (all.back() != '\n') count++;
+            return count;
+        }
+
+        /**
+         * Length of the first line, which is the width of the grid days
+         */
+        size_t width() const {
+            std::string_view first;
+            Lines cursor = lines();
+            if (!cursor.next(first)) return 0;
+            return first.size();
+        }
+
+    private:
+        Input(const char* data, size_t size) : _data(data), _size(size) {}
+
+        void load(int fd) {
+            struct stat info {};
+            if (::fstat(fd, &info) != 0)
+                throw InputError("Coudn't find input file");
+
+            if (S_ISREG(info.st_mode)) {
+                _size = info.st_size;
+            } else {
+                readAll(fd);
+            }
+
+            if (_data == nullptr && _size > 0) {
+                void* mapped = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE,
+                                      fd, 0);
+                if (mapped == MAP_FAILED)
+                    throw InputError("Coudn't map input file");
+                ::madvise(mapped, _size, MADV_SEQUENTIAL);
+                _data = static_cast<const char*>(mapped);
+                _mapped = true;
+            }
+        }
+
+        void readAll(int fd) {
+            const size_t CHUNK = 64 * 1024;
+            while (true) {
+                size_t used = _buffer.size();
+                _buffer.resize(used + CHUNK);
+                size_t count = readSome(fd, _buffer.data() + used, CHUNK);
+                _buffer.resize(used + count);
+                if (count == 0) break;
+            }
+            _data = _buffer.data();
+            _size = _buffer.size();
+        }
+
+        const char* _data = nullptr;
+        size_t _size = 0;
+        bool _mapped = false;
+        // only used when the input couldn't be mapped
+        std::vector<char> _buffer;
+    };
+
+    /**
+     * Lines read from a file descriptor a chunk at a time, for the days that
+     * can solve as the input arrives. Only the current chunk is held, plus
+     * the start of a line that runs over its end, so memory stays bounded
+     * by the chunk size and the longest line no matter how much is read.
+     *
+     * A line handed out by next() is only valid until the following call.
+     */
+    class LineStream {
+    public:
+        explicit LineStream(int fd, size_t chunkSize = 64 * 1024)
+            : _fd(fd), _buffer(chunkSize) {}
+
+        bool next(std::string_view& line) {
+            while (true) {
+                const char* start = _buffer.data() + _start;
+                size_t pending = _end - _start;
+                const void* found =
+                    std::memchr(start + _scanned, '\n', pending - _scanned);
+                if (found != nullptr) {
+                    size_t length = static_cast<const char*>(found) - start;
+                    AOC_COUNT("lines read", 1);
+                    line = std::string_view(start, length);
+                    _start += length + 1;
+                    _scanned = 0;
+                    return true;
+                }
+                _scanned = pending;
+
+                if (_eof) {
+                    // a last line without a trailing newline
+                    if (pending == 0) return false;
+                    AOC_COUNT("lines read", 1);
+                    line = std::string_view(start, pending);
+                    _start = _end;
+                    _scanned = 0;
+                    return true;
+                }
+                fill();
+            }
+        }
+
+    private:
+        /**
+         * Move the unfinished line to the front and read after it, growing
+         * the buffer only when that line already fills it
+         */
+        void fill() {
+            size_t pending = _end - _start;
+            if (_start > 0) {
+                std::memmove(_buffer.data(), _buffer.data() + _start, pending);
+                _start = 0;
+                _end = pending;
+            }
+            if (_end == _buffer.size()) _buffer.resize(_buffer.size() * 2);
+
+            size_t count =
+                readSome(_fd, _buffer.data() + _end, _buffer.size() - _end);
+            AOC_COUNT("bytes read", count);
+            if (count == 0) _eof = true;
+            _end += count;
+        }
+
+        int _fd;
+        std::vector<char> _buffer;
+        size_t _start = 0;
+        size_t _end = 0;
+        // bytes after _start already known to hold no newline
+        size_t _scanned = 0;
+        bool _eof = false;
+    };
+}  // namespace aoc
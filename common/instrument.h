@@ -0,0 +1,320 @@
+#pragma once
+
+/**
+ * Hot path instrumentation
+ *
+ * Scoped timers and event counters for finding where a day spends its time.
+ * They only exist when built with -DAOC_INSTRUMENT (make INSTRUMENT=1);
+ * otherwise every macro below expands to nothing and its arguments aren't
+ * evaluated, so they can stay in the hottest loops.
+ *
+ *     AOC_COUNT("map lookups", 1);       add to a counter
+ *     AOC_MAX("queue length", size);     keep the largest value seen
+ *     AOC_TIMER("getDstFromRanges");     time the rest of the scope
+ *     AOC_DEPTH("countCopies depth");    recursion depth of this scope
+ *     AOC_PHASE(aoc::instrument::PART1); attribute the rest of the scope
+ *
+ * Everything is recorded against the phase the calling thread is in, which
+ * the runner sets around parse, part 1 and part 2, and is written out as
+ * JSON per phase at the end of the run (--stats).
+ *
+ * Instrumented builds also replace the global operator new and delete to
+ * count every heap allocation, its bytes and the peak of live heap bytes
+ * per phase, and report the process's peak RSS alongside. A phase that
+ * allocates far more than its input is large is usually copying something
+ * by value. The replacements are in instrument_heap.h, which only a
+ * program's main.cpp includes; this header can go anywhere.
+ */
+
+#ifdef AOC_INSTRUMENT
+
+#include <malloc.h>
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace aoc {
+    namespace instrument {
+        enum Phase : int { OTHER, PARSE, PART1, PART2, PHASE_COUNT };
+
+        inline const char* phaseName(int phase) {
+            static const char* names[] = {"other", "parse", "part1", "part2"};
+            return names[phase];
+        }
+
+        inline int& currentPhase() {
+            thread_local int phase = OTHER;
+            return phase;
+        }
+
+        enum Kind { COUNT, MAX, TIMER };
+
+        /**
+         * One instrumented line of code. Sites register themselves the first
+         * time they run and live until the program exits.
+         */
+        struct Site {
+            const char* name;
+            Kind kind;
+            std::atomic<uint64_t> value[PHASE_COUNT] {};
+            std::atomic<uint64_t> calls[PHASE_COUNT] {};
+
+            Site(const char* siteName, Kind siteKind)
+                : name(siteName), kind(siteKind) {
+                std::lock_guard<std::mutex> lock(registryMutex());
+                registry().push_back(this);
+            }
+
+            void add(uint64_t amount) {
+                int phase = currentPhase();
+                value[phase].fetch_add(amount, std::memory_order_relaxed);
+                calls[phase].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void max(uint64_t candidate) {
+                std::atomic<uint64_t>& slot = value[currentPhase()];
+                uint64_t seen = slot.load(std::memory_order_relaxed);
+                while (candidate > seen &&
+                       !slot.compare_exchange_weak(seen, candidate,
+                                                   std::memory_order_relaxed))
+                    ;
+            }
+
+            static std::vector<Site*>& registry() {
+                static std::vector<Site*> sites;
+                return sites;
+            }
+
+            static std::mutex& registryMutex() {
+                static std::mutex mutex;
+                return mutex;
+            }
+        };
+
+        class ScopedTimer {
+        public:
+            explicit ScopedTimer(Site& site)
+                : _site(site), _start(std::chrono::steady_clock::now()) {}
+
+            ~ScopedTimer() {
+                auto elapsed = std::chrono::steady_clock::now() - _start;
+                _site.add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              elapsed)
+                              .count());
+            }
+
+        private:
+            Site& _site;
+            std::chrono::steady_clock::time_point _start;
+        };
+
+        class ScopedDepth {
+        public:
+            ScopedDepth(Site& site, int& depth) : _depth(depth) {
+                site.max(++_depth);
+            }
+            ~ScopedDepth() { _depth--; }
+
+        private:
+            int& _depth;
+        };
+
+        /**
+         * Switches the thread's phase for a scope and times the phase itself
+         */
+        class ScopedPhase {
+        public:
+            explicit ScopedPhase(Phase phase)
+                : _previous(currentPhase()),
+                  _start(std::chrono::steady_clock::now()) {
+                currentPhase() = phase;
+            }
+
+            ~ScopedPhase() {
+                auto elapsed = std::chrono::steady_clock::now() - _start;
+                phaseTime()[currentPhase()].fetch_add(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        elapsed)
+                        .count(),
+                    std::memory_order_relaxed);
+                currentPhase() = _previous;
+            }
+
+            static std::atomic<uint64_t>* phaseTime() {
+                static std::atomic<uint64_t> times[PHASE_COUNT] {};
+                return times;
+            }
+
+        private:
+            int _previous;
+            std::chrono::steady_clock::time_point _start;
+        };
+
+        /**
+         * Heap use per phase, fed by operator new and delete in
+         * instrument_heap.h. Sizes are what malloc actually set aside, so a
+         * free is matched to its allocation without storing a header. Live
+         * bytes are for the whole process; a phase's peak is the most that
+         * was live while any thread in that phase allocated.
+         */
+        struct Allocations {
+            std::atomic<uint64_t> count[PHASE_COUNT] {};
+            std::atomic<uint64_t> bytes[PHASE_COUNT] {};
+            std::atomic<uint64_t> peakLive[PHASE_COUNT] {};
+            std::atomic<uint64_t> live {0};
+
+            void allocated(void* block) {
+                uint64_t size = malloc_usable_size(block);
+                int phase = currentPhase();
+                count[phase].fetch_add(1, std::memory_order_relaxed);
+                bytes[phase].fetch_add(size, std::memory_order_relaxed);
+
+                uint64_t now =
+                    live.fetch_add(size, std::memory_order_relaxed) + size;
+                std::atomic<uint64_t>& peak = peakLive[phase];
+                uint64_t seen = peak.load(std::memory_order_relaxed);
+                while (now > seen &&
+                       !peak.compare_exchange_weak(seen, now,
+                                                   std::memory_order_relaxed))
+                    ;
+            }
+
+            void freed(void* block) {
+                live.fetch_sub(malloc_usable_size(block),
+                               std::memory_order_relaxed);
+            }
+        };
+
+        inline Allocations& allocations() {
+            static Allocations totals;
+            return totals;
+        }
+
+        inline long peakRssKb() {
+            struct rusage usage {};
+            ::getrusage(RUSAGE_SELF, &usage);
+            return usage.ru_maxrss;
+        }
+
+        /**
+         * Every site's totals per phase. Sites that share a name are added
+         * together (or the larger kept, for AOC_MAX).
+         */
+        inline void writeJson(std::ostream& out) {
+            struct total {
+                Kind kind;
+                uint64_t value = 0;
+                uint64_t calls = 0;
+            };
+
+            std::lock_guard<std::mutex> lock(Site::registryMutex());
+            out << "{\n  \"phases\": {";
+            bool firstPhase = true;
+            for (int phase = 0; phase < PHASE_COUNT; phase++) {
+                std::map<std::string, total> totals;
+                for (const Site* site : Site::registry()) {
+                    uint64_t value = site->value[phase].load();
+                    uint64_t calls = site->calls[phase].load();
+                    if (value == 0 && calls == 0) continue;
+
+                    auto slot =
+                        totals.try_emplace(site->name, total {site->kind});
+                    total& sum = slot.first->second;
+                    if (site->kind == MAX) {
+                        if (value > sum.value) sum.value = value;
+                    } else {
+                        sum.value += value;
+                    }
+                    sum.calls += calls;
+                }
+
+                uint64_t time = ScopedPhase::phaseTime()[phase].load();
+                const Allocations& heap = allocations();
+                uint64_t allocs = heap.count[phase].load();
+                if (totals.empty() && time == 0 && allocs == 0) continue;
+
+                out << (firstPhase ? "\n" : ",\n");
+                firstPhase = false;
+                out << "    \"" << phaseName(phase) << "\": {\"time_ns\": "
+                    << time << ", \"allocations\": {\"count\": " << allocs
+                    << ", \"bytes\": " << heap.bytes[phase].load()
+                    << ", \"peak_live_bytes\": "
+                    << heap.peakLive[phase].load() << "}";
+
+                const char* sections[] = {"counters", "max", "timers"};
+                for (int kind = COUNT; kind <= TIMER; kind++) {
+                    out << ", \"" << sections[kind] << "\": {";
+                    bool first = true;
+                    for (const auto& [name, sum] : totals) {
+                        if (sum.kind != kind) continue;
+                        out << (first ? "" : ", ") << "\"" << name << "\": ";
+                        first = false;
+                        if (kind == TIMER)
+                            out << "{\"calls\": " << sum.calls
+                                << ", \"time_ns\": " << sum.value << "}";
+                        else
+                            out << sum.value;
+                    }
+                    out << "}";
+                }
+                out << "}";
+            }
+            out << "\n  },\n  \"peak_rss_kb\": " << peakRssKb() << "\n}\n";
+        }
+    }  // namespace instrument
+}  // namespace aoc
+
+#define AOC_INSTRUMENT_JOIN2(a, b) a##b
+#define AOC_INSTRUMENT_JOIN(a, b) AOC_INSTRUMENT_JOIN2(a, b)
+#define AOC_INSTRUMENT_SITE(name, kind)                                      \
+    static ::aoc::instrument::Site AOC_INSTRUMENT_JOIN(aocSite, __LINE__)( \
+        name, ::aoc::instrument::kind)
+
+#define AOC_COUNT(name, amount)                               \
+    do {                                                      \
+        static ::aoc::instrument::Site aocSite(               \
+            name, ::aoc::instrument::COUNT);                  \
+        aocSite.add(amount);                                  \
+    } while (0)
+
+#define AOC_MAX(name, candidate)                              \
+    do {                                                      \
+        static ::aoc::instrument::Site aocSite(               \
+            name, ::aoc::instrument::MAX);                    \
+        aocSite.max(candidate);                               \
+    } while (0)
+
+#define AOC_TIMER(name)                                       \
+    AOC_INSTRUMENT_SITE(name, TIMER);                         \
+    ::aoc::instrument::ScopedTimer AOC_INSTRUMENT_JOIN(       \
+        aocTimer, __LINE__)(AOC_INSTRUMENT_JOIN(aocSite, __LINE__))
+
+#define AOC_DEPTH(name)                                                 \
+    AOC_INSTRUMENT_SITE(name, MAX);                                     \
+    static thread_local int AOC_INSTRUMENT_JOIN(aocDepth, __LINE__) = 0; \
+    ::aoc::instrument::ScopedDepth AOC_INSTRUMENT_JOIN(aocScope, __LINE__)( \
+        AOC_INSTRUMENT_JOIN(aocSite, __LINE__),                         \
+        AOC_INSTRUMENT_JOIN(aocDepth, __LINE__))
+
+#define AOC_PHASE(phase)                                      \
+    ::aoc::instrument::ScopedPhase AOC_INSTRUMENT_JOIN(       \
+        aocPhase, __LINE__)(phase)
+
+#else
+
+#define AOC_COUNT(name, amount) ((void)0)
+#define AOC_MAX(name, candidate) ((void)0)
+#define AOC_TIMER(name) ((void)0)
+#define AOC_DEPTH(name) ((void)0)
+#define AOC_PHASE(phase) ((void)0)
+
+#endif
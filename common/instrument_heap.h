@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "instrument.h"
+
+/**
+ * The global operator new and delete of an instrumented build, counting
+ * every allocation into instrument::allocations() (see instrument.h).
+ * These are definitions, not declarations, so every program includes this
+ * from exactly one translation unit, its main.cpp. Without AOC_INSTRUMENT
+ * it's empty.
+ */
+
+#ifdef AOC_INSTRUMENT
+
+/**
+ * The rest of operator new and delete (arrays, nothrow, sized) are defined
+ * by the standard library in terms of these four, so they're counted too.
+ */
+void* operator new(std::size_t size) {
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (block == nullptr) throw std::bad_alloc();
+    aoc::instrument::allocations().allocated(block);
+    return block;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    size_t align = static_cast<size_t>(alignment);
+    // aligned_alloc wants a non-zero multiple of the alignment
+    size_t rounded = size == 0 ? align : (size + align - 1) / align * align;
+    void* block = std::aligned_alloc(align, rounded);
+    if (block == nullptr) throw std::bad_alloc();
+    aoc::instrument::allocations().allocated(block);
+    return block;
+}
+
+void operator delete(void* block) noexcept {
+    if (block == nullptr) return;
+    aoc::instrument::allocations().freed(block);
+    std::free(block);
+}
+
+void operator delete(void* block, std::align_val_t) noexcept {
+    operator delete(block);
+}
+
+#endif
@@ -0,0 +1,330 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "input.h"
+
+/**
+ * Parsed models kept on disk between runs (--cache)
+ *
+ * A day opts in by wrapping the parse function it hands makeSolver():
+ *
+ *     const auto daySolver = aoc::makeSolver(
+ *         aoc::cached("day05/1", parse, save, load), part1, part2);
+ *
+ * where save(const Model&, ModelWriter&) writes the model out and
+ * load(ModelReader&) reads one back. The tag names the format; change
+ * it whenever the model or save() changes, and old caches are ignored.
+ *
+ * The cache sits next to the input as <input>.model and is only used
+ * while the input's size and content hash still match the ones it was
+ * written for, so editing the input just means one more parse. Anything
+ * wrong with the cache, from a bad header to a short read, falls back to
+ * parsing and rewriting it.
+ *
+ * The file is native-endian and padded so every array starts on an 8
+ * byte boundary, which lets load() copy arrays straight out of the
+ * mapping. It's meant for the machine that wrote it.
+ */
+
+namespace aoc {
+    /**
+     * 64-bit hash of the input, eight bytes at a time
+     */
+    inline uint64_t hashBytes(std::string_view data) {
+        const uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+        uint64_t hash = data.size() * MULTIPLIER;
+
+        size_t at = 0;
+        for (; at + 8 <= data.size(); at += 8) {
+            uint64_t word;
+            std::memcpy(&word, data.data() + at, 8);
+            hash = (hash ^ word) * MULTIPLIER;
+            hash ^= hash >> 29;
+        }
+        uint64_t tail = 0;
+        std::memcpy(&tail, data.data() + at, data.size() - at);
+        hash = (hash ^ tail) * MULTIPLIER;
+        return hash ^ (hash >> 32);
+    }
+
+    class ModelWriter {
+    public:
+        template <typename T>
+        void put(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            append(&value, sizeof(T));
+        }
+
+        template <typename T, typename Alloc>
+        void putArray(const std::vector<T, Alloc>& values) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            put<uint64_t>(values.size());
+            append(values.data(), values.size() * sizeof(T));
+        }
+
+        void putString(std::string_view text) {
+            put<uint64_t>(text.size());
+            append(text.data(), text.size());
+        }
+
+        const std::string& bytes() const { return _bytes; }
+
+    private:
+        void append(const void* data, size_t size) {
+            _bytes.append(static_cast<const char*>(data), size);
+            _bytes.resize((_bytes.size() + 7) & ~size_t(7), '\0');
+        }
+
+        std::string _bytes;
+    };
+
+    /**
+     * Reads back what a ModelWriter wrote. A read past the end fails and
+     * leaves the reader failed, so load() can read everything and check
+     * ok() once.
+     */
+    class ModelReader {
+    public:
+        explicit ModelReader(std::string_view bytes) : _rest(bytes) {}
+
+        bool ok() const { return _ok; }
+        bool atEnd() const { return _rest.empty(); }
+
+        /**
+         * For load() to reject what it read, e.g. sizes that don't agree
+         */
+        bool fail() {
+            _ok = false;
+            return false;
+        }
+
+        template <typename T>
+        bool get(T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const char* data = take(sizeof(T));
+            if (data != nullptr) std::memcpy(&value, data, sizeof(T));
+            return data != nullptr;
+        }
+
+        template <typename T, typename Alloc>
+        bool getArray(std::vector<T, Alloc>& values) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            uint64_t count = 0;
+            if (!get(count) || count > _rest.size() / sizeof(T))
+                return fail();
+            // arrays start 8-aligned in a page-aligned mapping
+            const T* first = reinterpret_cast<const T*>(
+                take(count * sizeof(T)));
+            if (first == nullptr) return false;
+            values.assign(first, first + count);
+            return true;
+        }
+
+        bool getString(std::string& text) {
+            uint64_t size = 0;
+            if (!get(size) || size > _rest.size()) return fail();
+            const char* data = take(size);
+            if (data == nullptr) return false;
+            text.assign(data, size);
+            return true;
+        }
+
+    private:
+        const char* take(size_t size) {
+            size_t padded = (size + 7) & ~size_t(7);
+            if (!_ok || padded > _rest.size()) {
+                fail();
+                return nullptr;
+            }
+            const char* data = _rest.data();
+            _rest.remove_prefix(padded);
+            return data;
+        }
+
+        std::string_view _rest;
+        bool _ok = true;
+    };
+
+    /**
+     * A parse function with the means to save and load its model, see
+     * cached()
+     */
+    template <typename ParseType, typename SaveType, typename LoadType>
+    struct CachedParse {
+        const char* tag;
+        ParseType parse;
+        SaveType save;
+        LoadType load;
+
+        auto operator()(const Input& input) const { return parse(input); }
+    };
+
+    template <typename ParseType, typename SaveType, typename LoadType>
+    CachedParse<ParseType, SaveType, LoadType> cached(const char* tag,
+                                                      ParseType parse,
+                                                      SaveType save,
+                                                      LoadType load) {
+        return {tag, parse, save, load};
+    }
+
+    template <typename T>
+    struct isCachedParse : std::false_type {};
+
+    template <typename ParseType, typename SaveType, typename LoadType>
+    struct isCachedParse<CachedParse<ParseType, SaveType, LoadType>>
+        : std::true_type {};
+
+    namespace detail {
+        struct CacheHeader {
+            char magic[8];
+            uint64_t inputSize;
+            uint64_t inputHash;
+            uint64_t tagSize;
+            uint64_t payloadSize;
+        };
+
+        const char CACHE_MAGIC[8] = {'A', 'O', 'C', 'M', 'O', 'D', 'E', 'L'};
+
+        /**
+         * The payload of the cache at path if it was written by tag for
+         * this input, kept mapped for as long as the CacheFile lives
+         */
+        class CacheFile {
+        public:
+            CacheFile(const std::string& path, const char* tag,
+                      uint64_t inputSize, uint64_t inputHash) {
+                int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) return;
+                struct stat info {};
+                if (::fstat(fd, &info) == 0 &&
+                    static_cast<size_t>(info.st_size) >= sizeof(CacheHeader)) {
+                    _size = info.st_size;
+                    void* mapped =
+                        ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (mapped != MAP_FAILED)
+                        _data = static_cast<const char*>(mapped);
+                }
+                ::close(fd);
+                if (_data == nullptr) return;
+
+                CacheHeader header;
+                std::memcpy(&header, _data, sizeof(header));
+                std::string_view rest(_data + sizeof(header),
+                                      _size - sizeof(header));
+                size_t tagSize = std::strlen(tag);
+                size_t paddedTag = (tagSize + 7) & ~size_t(7);
+                if (std::memcmp(header.magic, CACHE_MAGIC, 8) != 0 ||
+                    header.inputSize != inputSize ||
+                    header.inputHash != inputHash ||
+                    header.tagSize != tagSize || rest.size() < paddedTag ||
+                    rest.compare(0, tagSize, tag) != 0 ||
+                    header.payloadSize != rest.size() - paddedTag)
+                    return;
+                _payload = rest.substr(paddedTag);
+                _valid = true;
+            }
+
+            ~CacheFile() {
+                if (_data != nullptr)
+                    ::munmap(const_cast<char*>(_data), _size);
+            }
+
+            CacheFile(const CacheFile&) = delete;
+            CacheFile& operator=(const CacheFile&) = delete;
+
+            bool valid() const { return _valid; }
+            std::string_view payload() const { return _payload; }
+
+        private:
+            const char* _data = nullptr;
+            size_t _size = 0;
+            std::string_view _payload;
+            bool _valid = false;
+        };
+
+        /**
+         * Write the cache beside path and rename it into place, so a reader
+         * never sees half of one
+         */
+        inline bool writeCache(const std::string& path, const char* tag,
+                               uint64_t inputSize, uint64_t inputHash,
+                               const std::string& payload) {
+            CacheHeader header {};
+            std::memcpy(header.magic, CACHE_MAGIC, 8);
+            header.inputSize = inputSize;
+            header.inputHash = inputHash;
+            header.tagSize = std::strlen(tag);
+            header.payloadSize = payload.size();
+
+            std::string contents(reinterpret_cast<const char*>(&header),
+                                 sizeof(header));
+            contents.append(tag);
+            contents.resize((contents.size() + 7) & ~size_t(7), '\0');
+            contents += payload;
+
+            std::string temporary = path + ".XXXXXX";
+            int fd = ::mkstemp(temporary.data());
+            if (fd < 0) return false;
+            ::fchmod(fd, 0644);  // mkstemp makes it private to us
+            bool written = true;
+            for (size_t at = 0; written && at < contents.size();) {
+                ssize_t count = ::write(fd, contents.data() + at,
+                                        contents.size() - at);
+                if (count < 0 && errno == EINTR) continue;
+                written = count > 0;
+                at += written ? count : 0;
+            }
+            written = ::close(fd) == 0 && written &&
+                      std::rename(temporary.c_str(), path.c_str()) == 0;
+            if (!written) ::unlink(temporary.c_str());
+            return written;
+        }
+    }  // namespace detail
+
+    /**
+     * The model for input from the cache at path, or parsed and saved there
+     * when the cache is missing, stale or unreadable
+     */
+    template <typename ParseType, typename SaveType, typename LoadType>
+    auto parseCached(const Input& input,
+                     const CachedParse<ParseType, SaveType, LoadType>& parser,
+                     const std::string& path) {
+        using Model = decltype(parser.parse(input));
+
+        std::string_view data = input.data();
+        uint64_t inputHash = hashBytes(data);
+        {
+            detail::CacheFile file(path, parser.tag, data.size(), inputHash);
+            if (file.valid()) {
+                ModelReader reader(file.payload());
+                std::optional<Model> model(parser.load(reader));
+                if (reader.ok() && reader.atEnd()) return std::move(*model);
+            }
+        }
+
+        Model model = parser.parse(input);
+        ModelWriter writer;
+        parser.save(model, writer);
+        if (!detail::writeCache(path, parser.tag, data.size(), inputHash,
+                                writer.bytes()))
+            std::cerr << "Couldn't write the model cache " << path << "\n";
+        return model;
+    }
+}  // namespace aoc
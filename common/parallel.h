@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+#include "input.h"
+#include "instrument.h"
+#include "thread_pool.h"
+
+/**
+ * Map-reduce across cores for work made of independent pieces, like the
+ * lines of an input that can each be solved on their own.
+ *
+ *     long sum = aoc::reduceLines(
+ *         text, 0L, [](long& sum, std::string_view line) { ... },
+ *         [](long& total, long chunk) { total += chunk; });
+ *
+ * The work is cut into chunks of a fixed size, not one per core, so the
+ * chunks and the order their results are combined in are the same on
+ * every machine: each chunk folds its pieces into its own copy of the
+ * identity, in order, and the chunk results are then combined left to
+ * right on the calling thread. Anything that gives the right answer
+ * serially gives the same answer here.
+ *
+ * Work that fits in one chunk runs inline, so small inputs never start a
+ * thread. Folds run on pool threads, where arena() is plain new and
+ * delete. A fold that throws still lets the other chunks finish, and the
+ * exception is thrown from the reduction on the calling thread.
+ */
+
+namespace aoc {
+    namespace detail {
+        inline unsigned& reduceJobs() {
+            static unsigned jobs = 0;
+            return jobs;
+        }
+
+        inline std::mutex& reduceMutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        /**
+         * Room for the chunk results of the reduction that has the pool,
+         * kept from one reduction to the next so that solving again, on
+         * the same size of input, allocates nothing. Only touched with
+         * reduceMutex() held.
+         */
+        inline void* reduceSpace(size_t bytes) {
+            static std::unique_ptr<std::byte[]> space;
+            static size_t size = 0;
+            if (bytes > size) {
+                space.reset(new std::byte[bytes]);
+                size = bytes;
+            }
+            return space.get();
+        }
+
+        /**
+         * Start of piece of text when it's cut every chunkSize bytes: just
+         * after the first '\n' at or past chunkSize * piece - 1, so a line
+         * belongs to the piece its first byte falls in. Every piece can be
+         * found on its own, with nothing to keep between them.
+         */
+        inline size_t pieceStart(std::string_view text, size_t chunkSize,
+                                 size_t piece) {
+            if (piece == 0) return 0;
+            size_t from = chunkSize * piece - 1;
+            if (from >= text.size()) return text.size();
+            const void* found =
+                std::memchr(text.data() + from, '\n', text.size() - from);
+            if (found == nullptr) return text.size();
+            return static_cast<const char*>(found) - text.data() + 1;
+        }
+    }  // namespace detail
+
+    /**
+     * Threads for reductions, 0 is one per core. Only takes effect before
+     * the first reduction that needs the pool.
+     */
+    inline void setReduceJobs(unsigned jobs) { detail::reduceJobs() = jobs; }
+
+    inline ThreadPool& reducePool() {
+        static ThreadPool pool(detail::reduceJobs());
+        return pool;
+    }
+
+    /**
+     * Fold [0, count) in chunks of grain: fold(result, begin, end) adds
+     * those indices to a chunk's result, combine(total, chunk) merges a
+     * chunk's result into the total
+     */
+    template <typename Result, typename Fold, typename Combine>
+    Result parallelReduce(size_t count, size_t grain, const Result& identity,
+                          Fold fold, Combine combine) {
+        static_assert(alignof(Result) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        grain = std::max<size_t>(grain, 1);
+        size_t chunks = (count + grain - 1) / grain;
+        auto foldChunk = [&](Result& result, size_t chunk) {
+            size_t begin = chunk * grain;
+            fold(result, begin, std::min(begin + grain, count));
+        };
+
+        // a reduction already running (from the other part under
+        // --parallel, or another file in a batch) has the pool, so this one
+        // runs its chunks inline, combining each as it's done
+        std::unique_lock<std::mutex> lock(detail::reduceMutex(),
+                                          std::defer_lock);
+        if (chunks <= 1 || !lock.try_lock()) {
+            Result total = identity;
+            if (chunks > 0) foldChunk(total, 0);
+            for (size_t chunk = 1; chunk < chunks; chunk++) {
+                Result result = identity;
+                foldChunk(result, chunk);
+                combine(total, result);
+            }
+            return total;
+        }
+
+        Result* results = static_cast<Result*>(
+            detail::reduceSpace(chunks * sizeof(Result)));
+        std::uninitialized_fill_n(results, chunks, identity);
+        try {
+#ifdef AOC_INSTRUMENT
+            int phase = instrument::currentPhase();
+            reducePool().parallelFor(chunks, [&](size_t chunk) {
+                int& current = instrument::currentPhase();
+                int previous = std::exchange(current, phase);
+                try {
+                    foldChunk(results[chunk], chunk);
+                } catch (...) {
+                    current = previous;
+                    throw;
+                }
+                current = previous;
+            });
+#else
+            reducePool().parallelFor(chunks, [&](size_t chunk) {
+                foldChunk(results[chunk], chunk);
+            });
+#endif
+        } catch (...) {
+            std::destroy_n(results, chunks);
+            throw;
+        }
+
+        Result total = std::move(results[0]);
+        for (size_t chunk = 1; chunk < chunks; chunk++)
+            combine(total, results[chunk]);
+        std::destroy_n(results, chunks);
+        return total;
+    }
+
+    /**
+     * parallelReduce() over the lines of text, split the way Lines splits
+     * them: kernel(result, line) folds one line into its chunk's result.
+     * Chunks are about chunkSize bytes each, see detail::pieceStart().
+     */
+    template <typename Result, typename Kernel, typename Combine>
+    Result reduceLines(std::string_view text, const Result& identity,
+                       Kernel kernel, Combine combine,
+                       size_t chunkSize = 1 << 20) {
+        size_t pieces = (text.size() + chunkSize - 1) / chunkSize;
+        return parallelReduce(
+            pieces, 1, identity,
+            [&](Result& result, size_t begin, size_t end) {
+                size_t from = detail::pieceStart(text, chunkSize, begin);
+                size_t to = detail::pieceStart(text, chunkSize, end);
+                Lines lines(text.substr(from, to - from));
+                std::string_view line;
+                while (lines.next(line)) kernel(result, line);
+            },
+            combine);
+    }
+}  // namespace aoc
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace aoc {
+    /**
+     * Integer parsing straight off a string_view, without the std::string
+     * copy and the exceptions that std::stoi and friends come with.
+     *
+     *     long value;
+     *     if (!aoc::parseInt(token, value)) ...   whole token, or false
+     *     size_t used = aoc::parseIntPrefix(line, value);   leading number
+     *     long value = aoc::toInt<long>(token);   0 if token isn't a number
+     *
+     * Digits are converted eight at a time with SWAR arithmetic on a 64-bit
+     * word, so a puzzle number of up to eight digits costs one load and a
+     * handful of multiplies instead of a loop.
+     */
+    namespace detail {
+        constexpr uint64_t ONES = 0x0101010101010101;
+
+        /**
+         * Every byte of chunk is '0' to '9'
+         */
+        inline bool allDigits(uint64_t chunk) {
+            return ((chunk & (0xF0 * ONES)) |
+                    (((chunk + 0x06 * ONES) & (0xF0 * ONES)) >> 4)) ==
+                   0x33 * ONES;
+        }
+
+        /**
+         * Value of eight ASCII digits, the first one in the lowest byte
+         */
+        inline uint64_t eightDigits(uint64_t chunk) {
+            const uint64_t mask = 0x000000FF000000FF;
+            const uint64_t mul1 = 100 + (1000000ULL << 32);
+            const uint64_t mul2 = 1 + (10000ULL << 32);
+            chunk -= '0' * ONES;
+            chunk = (chunk * 10) + (chunk >> 8);
+            return (((chunk & mask) * mul1) +
+                    (((chunk >> 16) & mask) * mul2)) >>
+                   32;
+        }
+
+        /**
+         * Up to eight digits, left padded with '0' to fill the word so the
+         * same conversion works for every length
+         */
+        inline bool shortDigits(const char* digits, size_t count,
+                                uint64_t& value) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            uint64_t chunk = '0' * ONES;
+            std::memcpy(reinterpret_cast<char*>(&chunk) + (8 - count), digits,
+                        count);
+            if (!allDigits(chunk)) return false;
+            value = eightDigits(chunk);
+            return true;
+#else
+            value = 0;
+            for (size_t i = 0; i < count; i++) {
+                unsigned digit = static_cast<unsigned char>(digits[i]) - '0';
+                if (digit > 9) return false;
+                value = value * 10 + digit;
+            }
+            return true;
+#endif
+        }
+
+        /**
+         * Nothing but digits, and the value fits in 64 bits
+         */
+        inline bool parseDigits(std::string_view digits, uint64_t& value) {
+            static const uint64_t powers[] = {1,       10,       100,
+                                              1000,    10000,    100000,
+                                              1000000, 10000000, 100000000};
+            if (digits.empty()) return false;
+
+            uint64_t result = 0;
+            size_t at = 0;
+            while (at < digits.size()) {
+                size_t count = digits.size() - at;
+                if (count > 8) count = 8;
+
+                uint64_t chunk;
+                if (!shortDigits(digits.data() + at, count, chunk))
+                    return false;
+                if (__builtin_mul_overflow(result, powers[count], &result) ||
+                    __builtin_add_overflow(result, chunk, &result))
+                    return false;
+                at += count;
+            }
+            value = result;
+            return true;
+        }
+
+        inline size_t countDigits(std::string_view text, size_t from) {
+            size_t end = from;
+            while (end < text.size() && text[end] >= '0' && text[end] <= '9')
+                end++;
+            return end - from;
+        }
+    }  // namespace detail
+
+    /**
+     * Parse all of text as a decimal integer. A leading '-' is accepted for
+     * signed types. Returns false, leaving value alone, if text is empty,
+     * has anything but digits in it or doesn't fit in Int.
+     */
+    template <typename Int>
+    bool parseInt(std::string_view text, Int& value) {
+        static_assert(std::is_integral_v<Int>, "parseInt needs an integer");
+        using Unsigned = std::make_unsigned_t<Int>;
+
+        bool negative = false;
+        if constexpr (std::is_signed_v<Int>) {
+            if (!text.empty() && text[0] == '-') {
+                negative = true;
+                text.remove_prefix(1);
+            }
+        }
+
+        uint64_t magnitude;
+        if (!detail::parseDigits(text, magnitude)) return false;
+
+        uint64_t limit = std::numeric_limits<Int>::max();
+        if (negative) limit += 1;
+        if (magnitude > limit) return false;
+
+        Unsigned bits = static_cast<Unsigned>(magnitude);
+        value = static_cast<Int>(negative ? Unsigned(0) - bits : bits);
+        return true;
+    }
+
+    /**
+     * Parse the number text starts with. Returns how many characters it
+     * took, or 0 if text doesn't start with a number that fits in Int.
+     */
+    template <typename Int>
+    size_t parseIntPrefix(std::string_view text, Int& value) {
+        size_t sign = 0;
+        if constexpr (std::is_signed_v<Int>) {
+            if (!text.empty() && text[0] == '-') sign = 1;
+        }
+
+        size_t length = sign + detail::countDigits(text, sign);
+        if (!parseInt(text.substr(0, length), value)) return 0;
+        return length;
+    }
+
+    /**
+     * For input that is known to be well formed: the value of text, or 0 if
+     * it isn't a number after all
+     */
+    template <typename Int>
+    Int toInt(std::string_view text) {
+        Int value = 0;
+        parseInt(text, value);
+        return value;
+    }
+}  // namespace aoc
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace aoc {
+    /**
+     * Hardware performance counters for the calling thread, through
+     * perf_event_open(2). Each counter is opened on its own, so a machine or
+     * VM that only has some of them still reports those; one that has none
+     * (or a kernel.perf_event_paranoid that forbids them) leaves the set
+     * empty and says why, and the caller carries on with wall time alone.
+     *
+     * Only user space is counted, which is what an unprivileged process is
+     * allowed at the default paranoid level. When the PMU has fewer slots
+     * than counters the kernel time-shares them, and values are scaled up by
+     * how long each one actually ran.
+     */
+    class PerfCounters {
+    public:
+        PerfCounters() {
+            for (const spec& counter : specs()) {
+                perf_event_attr attr {};
+                attr.size = sizeof(attr);
+                attr.type = counter.type;
+                attr.config = counter.config;
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                   PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                long fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1,
+                                    PERF_FLAG_FD_CLOEXEC);
+                if (fd < 0) {
+                    if (_missing.empty()) _error = std::strerror(errno);
+                    _missing.push_back(counter.name);
+                    continue;
+                }
+                _fds.push_back(static_cast<int>(fd));
+                _names.push_back(counter.name);
+            }
+        }
+
+        ~PerfCounters() {
+            for (int fd : _fds) ::close(fd);
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        size_t size() const { return _fds.size(); }
+        const char* name(size_t i) const { return _names[i]; }
+
+        /**
+         * Counters that couldn't be opened, and why the first one failed
+         */
+        const std::vector<const char*>& missing() const { return _missing; }
+        const std::string& error() const { return _error; }
+
+        void start() {
+            for (int fd : _fds) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+
+        /**
+         * Stop counting and put each counter's value since start() in
+         * values, in the same order as name()
+         */
+        void stop(std::vector<uint64_t>& values) {
+            for (int fd : _fds) ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            values.assign(_fds.size(), 0);
+            for (size_t i = 0; i < _fds.size(); i++) {
+                uint64_t reading[3] = {};  // value, enabled, running
+                if (::read(_fds[i], reading, sizeof(reading)) !=
+                        static_cast<ssize_t>(sizeof(reading)) ||
+                    reading[2] == 0)
+                    continue;
+                values[i] = reading[2] == reading[1]
+                                ? reading[0]
+                                : static_cast<uint64_t>(
+                                      static_cast<double>(reading[0]) *
+                                      reading[1] / reading[2]);
+            }
+        }
+
+    private:
+        struct spec {
+            const char* name;
+            uint32_t type;
+            uint64_t config;
+        };
+
+        static constexpr uint64_t cacheMiss(uint64_t cache) {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+
+        static const std::vector<spec>& specs() {
+            static const std::vector<spec> all = {
+                {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {"instructions", PERF_TYPE_HARDWARE,
+                 PERF_COUNT_HW_INSTRUCTIONS},
+                {"branch-misses", PERF_TYPE_HARDWARE,
+                 PERF_COUNT_HW_BRANCH_MISSES},
+                {"L1d-misses", PERF_TYPE_HW_CACHE,
+                 cacheMiss(PERF_COUNT_HW_CACHE_L1D)},
+                {"LLC-misses", PERF_TYPE_HW_CACHE,
+                 cacheMiss(PERF_COUNT_HW_CACHE_LL)},
+                {"dTLB-misses", PERF_TYPE_HW_CACHE,
+                 cacheMiss(PERF_COUNT_HW_CACHE_DTLB)},
+                {"page-faults", PERF_TYPE_SOFTWARE,
+                 PERF_COUNT_SW_PAGE_FAULTS},
+            };
+            return all;
+        }
+
+        std::vector<int> _fds;
+        std::vector<const char*> _names;
+        std::vector<const char*> _missing;
+        std::string _error;
+    };
+}  // namespace aoc
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+    namespace detail {
+        /**
+         * Just enough of io_uring(7) to queue reads and wait for them, on
+         * the raw system calls. A kernel without io_uring, or a sandbox
+         * that blocks it, leaves the ring closed and ok() false.
+         *
+         * Only one thread may use a ring.
+         */
+        class ReadRing {
+        public:
+            explicit ReadRing(unsigned entries) {
+                io_uring_params params {};
+                long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+                if (fd < 0) return;
+                _fd = static_cast<int>(fd);
+
+                _sqSize = params.sq_off.array + params.sq_entries * 4;
+                _cqSize = params.cq_off.cqes +
+                          params.cq_entries * sizeof(io_uring_cqe);
+                // older kernels map the two rings separately
+                bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+                if (single) _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+
+                _sq = map(_sqSize, IORING_OFF_SQ_RING);
+                _cq = single ? _sq : map(_cqSize, IORING_OFF_CQ_RING);
+                _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                _sqes = static_cast<io_uring_sqe*>(
+                    map(_sqesSize, IORING_OFF_SQES));
+                if (_sq == nullptr || _cq == nullptr || _sqes == nullptr) {
+                    close();
+                    return;
+                }
+
+                _sqTail = at<unsigned>(_sq, params.sq_off.tail);
+                _sqMask = *at<unsigned>(_sq, params.sq_off.ring_mask);
+                _sqArray = at<unsigned>(_sq, params.sq_off.array);
+                _cqHead = at<unsigned>(_cq, params.cq_off.head);
+                _cqTail = at<unsigned>(_cq, params.cq_off.tail);
+                _cqMask = *at<unsigned>(_cq, params.cq_off.ring_mask);
+                _cqes = at<io_uring_cqe>(_cq, params.cq_off.cqes);
+            }
+
+            ~ReadRing() { close(); }
+
+            ReadRing(const ReadRing&) = delete;
+            ReadRing& operator=(const ReadRing&) = delete;
+
+            bool ok() const { return _fd >= 0; }
+
+            /**
+             * Queue a read of size bytes at offset of fd into buffer. It is
+             * handed to the kernel by the next wait().
+             */
+            void read(int fd, char* buffer, size_t size, uint64_t offset,
+                      uint64_t userData) {
+                unsigned tail = *_sqTail;
+                unsigned slot = tail & _sqMask;
+                io_uring_sqe& sqe = _sqes[slot];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = IORING_OP_READ;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<uint64_t>(buffer);
+                // one read asks for at most 1 GB, under the kernel's limit
+                // of about 2 GB, so bigger files take several
+                sqe.len = static_cast<uint32_t>(
+                    std::min<size_t>(size, 1u << 30));
+                sqe.off = offset;
+                sqe.user_data = userData;
+                _sqArray[slot] = slot;
+                __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+                _unsubmitted++;
+            }
+
+            /**
+             * Submit what read() queued, then wait for one completion and
+             * return its user data and result: bytes read, or -errno.
+             * Returns false if the wait itself failed.
+             */
+            bool wait(uint64_t& userData, int& result) {
+                while (true) {
+                    unsigned head = *_cqHead;
+                    if (head != __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE)) {
+                        const io_uring_cqe& cqe = _cqes[head & _cqMask];
+                        userData = cqe.user_data;
+                        result = cqe.res;
+                        __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+                        return true;
+                    }
+
+                    long entered =
+                        ::syscall(__NR_io_uring_enter, _fd, _unsubmitted, 1,
+                                  IORING_ENTER_GETEVENTS, nullptr, 0);
+                    if (entered < 0 && errno != EINTR) return false;
+                    if (entered > 0) _unsubmitted -= entered;
+                }
+            }
+
+        private:
+            void* map(size_t size, off_t offset) {
+                void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_POPULATE, _fd, offset);
+                return mapped == MAP_FAILED ? nullptr : mapped;
+            }
+
+            template <typename T>
+            static T* at(void* ring, uint32_t offset) {
+                return reinterpret_cast<T*>(static_cast<char*>(ring) +
+                                            offset);
+            }
+
+            void close() {
+                if (_sqes != nullptr) ::munmap(_sqes, _sqesSize);
+                if (_cq != nullptr && _cq != _sq) ::munmap(_cq, _cqSize);
+                if (_sq != nullptr) ::munmap(_sq, _sqSize);
+                if (_fd >= 0) ::close(_fd);
+                _sq = _cq = nullptr;
+                _sqes = nullptr;
+                _fd = -1;
+            }
+
+            int _fd = -1;
+            void* _sq = nullptr;
+            void* _cq = nullptr;
+            io_uring_sqe* _sqes = nullptr;
+            size_t _sqSize = 0, _cqSize = 0, _sqesSize = 0;
+
+            unsigned* _sqTail = nullptr;
+            unsigned* _sqArray = nullptr;
+            unsigned _sqMask = 0;
+            unsigned* _cqHead = nullptr;
+            unsigned* _cqTail = nullptr;
+            io_uring_cqe* _cqes = nullptr;
+            unsigned _cqMask = 0;
+            unsigned _unsubmitted = 0;
+        };
+    }  // namespace detail
+
+    /**
+     * A file read in whole ahead of time, or why it couldn't be
+     */
+    struct PrefetchedFile {
+        size_t index = 0;
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+        std::string error;
+
+        std::string_view contents() const { return {data.get(), size}; }
+    };
+
+    /**
+     * Reads a list of files on a thread of its own, ahead of whoever
+     * solves them, and hands each one over as soon as it's in memory:
+     *
+     *     FilePrefetcher reader(files);
+     *     pool.parallelFor(files.size(), [&](size_t) {
+     *         PrefetchedFile file = reader.next();
+     *         ... solve file.contents() for files[file.index] ...
+     *     });
+     *
+     * Files are opened in order and their reads queued on an io_uring, so
+     * the kernel works on several at once while the caller computes; files
+     * come out of next() in the order their reads finish. Where io_uring
+     * can't be set up the same thread falls back to pread(2), which still
+     * keeps reading ahead, just one file at a time.
+     *
+     * At most depth files, holding no more than about maxBytes between
+     * them, are read but not yet taken by next(), so a long batch doesn't
+     * pull everything into memory; one file is always let through however
+     * big it is. Everything must be taken before the prefetcher goes away.
+     */
+    class FilePrefetcher {
+    public:
+        explicit FilePrefetcher(std::vector<std::string> files,
+                                size_t depth = 64,
+                                size_t maxBytes = size_t(256) << 20)
+            : _paths(std::move(files)),
+              _files(_paths.size()),
+              _depth(std::max<size_t>(depth, 1)),
+              _maxBytes(maxBytes) {
+            _reader = std::thread([this] { readAll(); });
+        }
+
+        ~FilePrefetcher() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _changed.notify_all();
+            _reader.join();
+            for (const pending& read : _pending)
+                if (read.fd >= 0) ::close(read.fd);
+        }
+
+        FilePrefetcher(const FilePrefetcher&) = delete;
+        FilePrefetcher& operator=(const FilePrefetcher&) = delete;
+
+        /**
+         * The next file to finish reading, waiting for one if need be.
+         * Only call it once per file.
+         */
+        PrefetchedFile next() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _changed.wait(lock, [&] { return !_ready.empty(); });
+            size_t index = _ready.front();
+            _ready.pop_front();
+            PrefetchedFile file = std::move(_files[index]);
+            _held--;
+            _heldBytes -= file.size;
+            lock.unlock();
+            _changed.notify_all();
+            return file;
+        }
+
+        /**
+         * Whether reads go through io_uring, known once the first file is
+         * out of next()
+         */
+        bool usingIoUring() const { return _usingRing; }
+
+    private:
+        struct pending {
+            int fd = -1;
+            size_t done = 0;
+        };
+
+        void readAll() {
+            detail::ReadRing ring(static_cast<unsigned>(_depth));
+            _usingRing = ring.ok();
+            _pending.resize(_paths.size());
+
+            size_t inFlight = 0;
+            for (size_t next = 0; next < _paths.size() || inFlight > 0;) {
+                // keep queueing files while the window has room, and wait
+                // for room when there's nothing in flight to collect
+                while (next < _paths.size()) {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    auto room = [&] {
+                        return _stopping ||
+                               (_held < _depth &&
+                                (_held == 0 || _heldBytes < _maxBytes));
+                    };
+                    if (inFlight == 0) _changed.wait(lock, room);
+                    // the kernel may still be writing into buffers that are
+                    // in flight, so those have to land before leaving
+                    if (_stopping && inFlight == 0) return;
+                    if (_stopping || !room()) break;
+                    _held++;
+                    lock.unlock();
+
+                    size_t index = next++;
+                    if (!open(index)) continue;
+                    if (_usingRing) {
+                        queueRead(ring, index);
+                        inFlight++;
+                    } else {
+                        readWithPread(index);
+                    }
+                }
+                if (inFlight == 0) continue;
+
+                uint64_t index = 0;
+                int result = 0;
+                if (!ring.wait(index, result)) {
+                    // the ring broke, finish what's left with pread
+                    _usingRing = false;
+                    for (size_t i = 0; i < next; i++)
+                        if (_pending[i].fd >= 0) readWithPread(i);
+                    inFlight = 0;
+                    continue;
+                }
+                if (result == -EINTR || result == -EAGAIN) {
+                    queueRead(ring, index);
+                    continue;
+                }
+                if (result == -EINVAL || result == -EOPNOTSUPP) {
+                    // a kernel from before IORING_OP_READ
+                    _usingRing = false;
+                    inFlight--;
+                    readWithPread(index);
+                    continue;
+                }
+
+                pending& read = _pending[index];
+                PrefetchedFile& file = _files[index];
+                if (result < 0) {
+                    file.error = std::strerror(-result);
+                } else if (result == 0) {
+                    file.size = read.done;  // shrank since it was opened
+                } else {
+                    read.done += result;
+                    if (read.done < file.size) {
+                        queueRead(ring, index);
+                        continue;
+                    }
+                }
+                inFlight--;
+                finish(index);
+            }
+        }
+
+        /**
+         * Open a file and size its buffer; false, with the file finished,
+         * when there's nothing to read
+         */
+        bool open(size_t index) {
+            PrefetchedFile& file = _files[index];
+            file.index = index;
+            int fd = ::open(_paths[index].c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat info {};
+            if (fd < 0 || ::fstat(fd, &info) != 0) {
+                file.error = std::strerror(errno);
+            } else if (!S_ISREG(info.st_mode)) {
+                file.error = "not a regular file";
+            } else {
+                file.size = info.st_size;
+                file.data.reset(new (std::nothrow) char[file.size]);
+                if (file.data == nullptr) file.error = "out of memory";
+            }
+
+            _pending[index].fd = fd;
+            if (!file.error.empty() || file.size == 0) {
+                finish(index);
+                return false;
+            }
+            return true;
+        }
+
+        void queueRead(detail::ReadRing& ring, size_t index) {
+            const pending& read = _pending[index];
+            PrefetchedFile& file = _files[index];
+            ring.read(read.fd, file.data.get() + read.done,
+                      file.size - read.done, read.done, index);
+        }
+
+        void readWithPread(size_t index) {
+            pending& read = _pending[index];
+            PrefetchedFile& file = _files[index];
+            while (read.done < file.size) {
+                ssize_t count = ::pread(read.fd, file.data.get() + read.done,
+                                        file.size - read.done, read.done);
+                if (count < 0 && errno == EINTR) continue;
+                if (count < 0) file.error = std::strerror(errno);
+                if (count <= 0) break;
+                read.done += count;
+            }
+            file.size = read.done;
+            finish(index);
+        }
+
+        /**
+         * Close a file and hand it to next()
+         */
+        void finish(size_t index) {
+            pending& read = _pending[index];
+            if (read.fd >= 0) ::close(read.fd);
+            read.fd = -1;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _heldBytes += _files[index].size;
+                _ready.push_back(index);
+            }
+            _changed.notify_all();
+        }
+
+        std::vector<std::string> _paths;
+        std::vector<PrefetchedFile> _files;
+        // only touched by the reading thread
+        std::vector<pending> _pending;
+        size_t _depth;
+        size_t _maxBytes;
+        std::atomic<bool> _usingRing {false};
+
+        std::mutex _mutex;
+        std::condition_variable _changed;
+        std::deque<size_t> _ready;
+        // files started but not yet taken, and the bytes of those read
+        size_t _held = 0;
+        size_t _heldBytes = 0;
+        bool _stopping = false;
+
+        std::thread _reader;
+    };
+}  // namespace aoc
@@ -0,0 +1,704 @@
+#pragma once
+
+#include <glob.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "arena.h"
+#include "bench.h"
+#include "input.h"
+#include "instrument.h"
+#include "parallel.h"
+#include "parse_int.h"
+#include "perf_counters.h"
+#include "prefetch.h"
+#include "socket.h"
+#include "solver.h"
+#include "thread_pool.h"
+
+namespace aoc {
+    /**
+     * Command line shared by every day:
+     *
+     *     main <input file> [--parallel] [--part 1|2] [--stream] [--jobs N]
+     *                       [--cache] [--bench <reps>] [--warmup <runs>]
+     *                       [--counters] [--stats <file>]
+     *                       [--check-allocations]
+     *     main --batch [<file or glob>...] [--manifest <file>] [--jobs N]
+     *                  [--part 1|2] [--cache]
+     *     main --serve <socket>
+     *
+     * The input file can be - to read stdin.
+     */
+    struct Options {
+        std::string inputFile;
+        // every file or glob given, only --batch takes more than one
+        std::vector<std::string> inputFiles;
+        // run part 1 and part 2 on their own threads
+        bool parallel = false;
+        // only solve this part, 0 solves both
+        int part = 0;
+        // solve while reading in chunks, for days that support it
+        bool stream = false;
+        // keep the parsed model beside the input, see model_cache.h
+        bool cache = false;
+        // time this many runs instead of printing answers, see bench()
+        int benchReps = 0;
+        int warmup = 1;
+        // also read hardware counters around each benchmarked phase
+        bool counters = false;
+        // solve many files in one process, see batch()
+        bool batch = false;
+        std::string manifest;
+        // threads for a batch, and for days that split their input across
+        // cores (see parallel.h), 0 is one per core
+        int jobs = 0;
+        // where instrumented builds write their JSON, stderr by default
+        std::string statsFile;
+        // fail if solving a part again allocates, see checkAllocations()
+        bool checkAllocations = false;
+        // answer requests on this Unix socket until killed, see serve()
+        std::string serveSocket;
+    };
+
+    /**
+     * Read the number following argv[i] into value
+     */
+    inline bool optionValue(int argc, char** argv, int& i, int& value) {
+        if (i + 1 >= argc) {
+            std::cout << "Missing value for " << argv[i] << "\n";
+            return false;
+        }
+
+        char* end = nullptr;
+        long parsed = std::strtol(argv[i + 1], &end, 10);
+        if (*end != '\0' || parsed < 0) {
+            std::cout << "Bad value for " << argv[i] << ": " << argv[i + 1]
+                      << "\n";
+            return false;
+        }
+
+        value = static_cast<int>(parsed);
+        i++;
+        return true;
+    }
+
+    inline bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--parallel") == 0) {
+                options.parallel = true;
+            } else if (std::strcmp(argv[i], "--stream") == 0) {
+                options.stream = true;
+            } else if (std::strcmp(argv[i], "--cache") == 0) {
+                options.cache = true;
+            } else if (std::strcmp(argv[i], "--counters") == 0) {
+                options.counters = true;
+            } else if (std::strcmp(argv[i], "--check-allocations") == 0) {
+                options.checkAllocations = true;
+            } else if (std::strcmp(argv[i], "--part") == 0) {
+                if (!optionValue(argc, argv, i, options.part)) return false;
+                if (options.part > 2) {
+                    std::cout << "Part must be 1 or 2\n";
+                    return false;
+                }
+            } else if (std::strcmp(argv[i], "--bench") == 0) {
+                if (!optionValue(argc, argv, i, options.benchReps))
+                    return false;
+            } else if (std::strcmp(argv[i], "--warmup") == 0) {
+                if (!optionValue(argc, argv, i, options.warmup)) return false;
+            } else if (std::strcmp(argv[i], "--batch") == 0) {
+                options.batch = true;
+            } else if (std::strcmp(argv[i], "--manifest") == 0) {
+                if (i + 1 >= argc) {
+                    std::cout << "Missing value for --manifest\n";
+                    return false;
+                }
+                options.manifest = argv[++i];
+            } else if (std::strcmp(argv[i], "--stats") == 0) {
+                if (i + 1 >= argc) {
+                    std::cout << "Missing value for --stats\n";
+                    return false;
+                }
+                options.statsFile = argv[++i];
+            } else if (std::strcmp(argv[i], "--serve") == 0) {
+                if (i + 1 >= argc) {
+                    std::cout << "Missing value for --serve\n";
+                    return false;
+                }
+                options.serveSocket = argv[++i];
+            } else if (std::strcmp(argv[i], "--jobs") == 0) {
+                if (!optionValue(argc, argv, i, options.jobs)) return false;
+            } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+                std::cout << "Unknown option " << argv[i] << "\n";
+                return false;
+            } else {
+                options.inputFiles.push_back(argv[i]);
+            }
+        }
+
+        if (!options.serveSocket.empty()) return true;
+        if (options.batch) {
+            if (options.inputFiles.empty() && options.manifest.empty()) {
+                std::cout << "No input files given\n";
+                return false;
+            }
+            return true;
+        }
+
+        if (options.inputFiles.empty()) {
+            std::cout << "No input file given\n";
+            return false;
+        }
+        if (options.inputFiles.size() > 1) {
+            std::cout << "Only one input file without --batch\n";
+            return false;
+        }
+        options.inputFile = options.inputFiles.front();
+        return true;
+    }
+
+    /**
+     * Where --cache keeps the model parsed from file, empty when there's no
+     * caching
+     */
+    inline std::string modelCachePath(const Options& options,
+                                      const std::string& file) {
+        if (!options.cache || file == "-") return "";
+        return file + ".model";
+    }
+
+    /**
+     * Solve the parts the options ask for against the same parsed model and
+     * print their answers in part order. The model is only ever read, so
+     * with --parallel part 1 is solved on its own thread while part 2 is
+     * solved on this one. Whatever part 1 throws there is thrown again here
+     * once the thread is joined, as if it had been solved on this thread.
+     */
+    inline void runParts(const Solver& solver, const Model& model,
+                         const Options& options, std::ostream& out) {
+        if (options.part != 0) {
+            out << solver.solve(model, options.part);
+            return;
+        }
+        if (!options.parallel) {
+            out << solver.solve(model, 1);
+            out << solver.solve(model, 2);
+            return;
+        }
+
+        Answer part1;
+        std::exception_ptr part1Error;
+        std::thread worker([&] {
+            try {
+                part1 = solver.solve(model, 1);
+            } catch (...) {
+                part1Error = std::current_exception();
+            }
+        });
+        Answer part2;
+        try {
+            part2 = solver.solve(model, 2);
+        } catch (...) {
+            worker.join();
+            throw;
+        }
+        worker.join();
+        if (part1Error) std::rethrow_exception(part1Error);
+
+        out << part1 << part2;
+    }
+
+    /**
+     * What bench() measured: one sample per timed run for each phase and,
+     * with --counters, for each counter in each phase
+     */
+    struct BenchRun {
+        Samples parse, part1, part2;
+        // names of the counters, in the order of the counts
+        std::vector<std::string> counters;
+        std::vector<Samples> parseCounts, part1Counts, part2Counts;
+        // counters the machine doesn't have, and why the first one failed
+        std::vector<std::string> missingCounters;
+        std::string counterError;
+    };
+
+    /**
+     * Time parse and each part separately over warm-up plus benchReps runs.
+     * Parsing includes opening and mapping the input, so it is redone every
+     * run, into an arena that is reset between runs. Answers are kept but
+     * not printed, which skips formatting but still does all the solving.
+     *
+     * With --counters each phase is also bracketed by hardware counters.
+     * Counters the machine doesn't have are left out and named in
+     * missingCounters; the times are the same either way.
+     */
+    inline BenchRun benchSolver(const Solver& solver, const Options& options) {
+        BenchRun result;
+        Arena arena;
+        std::string cachePath = modelCachePath(options, options.inputFile);
+        volatile int64_t answer = 0;
+
+        std::optional<PerfCounters> counters;
+        std::vector<uint64_t> values;
+        if (options.counters) {
+            counters.emplace();
+            for (size_t i = 0; i < counters->size(); i++)
+                result.counters.emplace_back(counters->name(i));
+            for (const char* name : counters->missing())
+                result.missingCounters.emplace_back(name);
+            result.counterError = counters->error();
+        }
+        auto startCounting = [&] {
+            if (counters) counters->start();
+        };
+        auto stopCounting = [&](bool timed, std::vector<Samples>& counts) {
+            if (!counters) return;
+            counters->stop(values);
+            if (!timed) return;
+            counts.resize(values.size());
+            for (size_t i = 0; i < values.size(); i++)
+                counts[i].push_back(static_cast<int64_t>(values[i]));
+        };
+        // kept across runs, so parts reuse their scratch space as they
+        // would solving many inputs
+        Workspace workspaces[2];
+        auto timePart = [&](const Model& model, int part, bool timed,
+                            Samples& times, std::vector<Samples>& counts) {
+            startCounting();
+            Clock::time_point start = Clock::now();
+            answer = solver.solve(model, part, workspaces[part - 1]).value;
+            Clock::time_point done = Clock::now();
+            stopCounting(timed, counts);
+            if (timed) times.push_back(elapsedNs(start, done));
+        };
+
+        for (int run = 0; run < options.warmup + options.benchReps; run++) {
+            bool timed = run >= options.warmup;
+            arena.reset();
+            ArenaScope scope(arena);
+
+            startCounting();
+            Clock::time_point start = Clock::now();
+            Input input(options.inputFile);
+            std::unique_ptr<Model> model = solver.parse(input, cachePath);
+            Clock::time_point parsed = Clock::now();
+            stopCounting(timed, result.parseCounts);
+            if (timed) result.parse.push_back(elapsedNs(start, parsed));
+
+            if (options.part != 2)
+                timePart(*model, 1, timed, result.part1, result.part1Counts);
+            if (options.part != 1)
+                timePart(*model, 2, timed, result.part2, result.part2Counts);
+        }
+        return result;
+    }
+
+    /**
+     * Write a BenchRun in the format read back by the harness in bench/:
+     * the times, then one line per phase and counter, e.g.
+     * "part1:instructions". Missing counters are named on a "#" line, which
+     * readSamples() skips.
+     */
+    inline void writeBench(std::ostream& out, const BenchRun& result,
+                           const Options& options) {
+        if (!result.missingCounters.empty()) {
+            out << "# missing counters:";
+            for (const std::string& name : result.missingCounters)
+                out << " " << name;
+            out << " (" << result.counterError << ")\n";
+        }
+
+        writeSamples(out, "parse", result.parse);
+        if (options.part != 2) writeSamples(out, "part1", result.part1);
+        if (options.part != 1) writeSamples(out, "part2", result.part2);
+
+        auto writeCounts = [&](const char* phase,
+                               const std::vector<Samples>& counts) {
+            for (size_t i = 0; i < counts.size(); i++)
+                writeSamples(out,
+                             std::string(phase) + ":" + result.counters[i],
+                             counts[i]);
+        };
+        writeCounts("parse", result.parseCounts);
+        writeCounts("part1", result.part1Counts);
+        writeCounts("part2", result.part2Counts);
+    }
+
+    inline int bench(const Options& options, const Solver& solver) {
+        writeBench(std::cout, benchSolver(solver, options), options);
+        return 0;
+    }
+
+    /**
+     * Files for a batch: the manifest's lines, skipping blanks and # comments,
+     * then every file or glob from the command line. Globs are expanded here
+     * as well as by the shell, so a quoted pattern in a job file still works.
+     */
+    inline std::vector<std::string> batchFiles(const Options& options) {
+        std::vector<std::string> patterns;
+        if (!options.manifest.empty()) {
+            Input manifest(options.manifest);
+            Lines lines = manifest.lines();
+            std::string_view line;
+            while (lines.next(line)) {
+                if (line.empty() || line.front() == '#') continue;
+                patterns.emplace_back(line);
+            }
+        }
+        patterns.insert(patterns.end(), options.inputFiles.begin(),
+                        options.inputFiles.end());
+
+        std::vector<std::string> files;
+        for (const auto& pattern : patterns) {
+            glob_t matches {};
+            if (pattern.find_first_of("*?[") != std::string::npos &&
+                ::glob(pattern.c_str(), 0, nullptr, &matches) == 0) {
+                for (size_t i = 0; i < matches.gl_pathc; i++)
+                    files.emplace_back(matches.gl_pathv[i]);
+            } else {
+                files.push_back(pattern);
+            }
+            ::globfree(&matches);
+        }
+        return files;
+    }
+
+    /**
+     * Solve every file of a batch on a work-stealing pool in this process.
+     * Files are read ahead on a thread of their own (see prefetch.h), and
+     * each worker takes whichever file is read next, so the pool only waits
+     * on storage when it outruns it. Each file is parsed once and its
+     * answers are collected in a buffer; the buffers are printed in the
+     * order the files were given, each under a "== <file>" header. A file
+     * that can't be read or parsed reports the error under its header
+     * without stopping the rest.
+     *
+     * solverFor(file) gives the solver for each file, or nullptr when there
+     * is none; a day's own binary solves every file with its one solver.
+     */
+    template <typename SolverFor>
+    int batch(const Options& options, SolverFor solverFor) {
+        std::vector<std::string> files = batchFiles(options);
+        std::vector<std::string> results(files.size());
+        std::vector<char> failed(files.size(), false);
+
+        Options fileOptions = options;
+        fileOptions.parallel = false;
+
+        ThreadPool pool(options.jobs);
+        FilePrefetcher reader(files);
+        pool.parallelFor(files.size(), [&](size_t) {
+            PrefetchedFile file = reader.next();
+            size_t i = file.index;
+            std::ostringstream out;
+            const Solver* solver = solverFor(files[i]);
+            if (files[i] == "-") {
+                out << "Coudn't find input file\n";
+                failed[i] = true;
+            } else if (!file.error.empty()) {
+                out << "Coudn't read input file: " << file.error << "\n";
+                failed[i] = true;
+            } else if (solver == nullptr) {
+                out << "No solver for this file\n";
+                failed[i] = true;
+            } else {
+                try {
+                    Arena arena;
+                    ArenaScope scope(arena);
+                    Input input = Input::borrow(file.contents());
+                    std::unique_ptr<Model> model = solver->parse(
+                        input, modelCachePath(options, files[i]));
+                    runParts(*solver, *model, fileOptions, out);
+                } catch (const std::exception& error) {
+                    out << "Failed: " << error.what() << "\n";
+                    failed[i] = true;
+                }
+            }
+            results[i] = out.str();
+        });
+
+        bool ok = true;
+        for (size_t i = 0; i < files.size(); i++) {
+            std::cout << "== " << files[i] << "\n" << results[i];
+            ok = ok && !failed[i];
+        }
+        return ok ? 0 : 1;
+    }
+
+    /**
+     * What a --serve connection reuses from one request to the next, and
+     * gives back when it closes
+     */
+    struct Connection {
+        std::string payload;
+        std::ostringstream out;
+        // the model of the request being answered
+        Arena arena;
+        // scratch space for each part
+        Workspace workspaces[2];
+    };
+
+    /**
+     * Answer one request read from a --serve client, see socket.h for the
+     * format. fields is the request's header after the day, if it has one;
+     * solver is that day's, or nullptr for a day that isn't served. Returns
+     * false when the client has gone away, or when its stream can't be
+     * followed any more and the connection has to close.
+     */
+    inline bool answerRequest(int fd, SocketReader& reader,
+                              std::istream& fields, const Solver* solver,
+                              Connection& connection) {
+        std::string& payload = connection.payload;
+        std::ostringstream& out = connection.out;
+        Arena& arena = connection.arena;
+        int part = -1;
+        std::string kind;
+        std::string argument;
+        fields >> part >> kind;
+        std::getline(fields >> std::ws, argument);
+
+        std::string error;
+        struct stat info {};
+        if (kind == "inline") {
+            // without a length there's no telling where the payload ends
+            // and the next header starts, so the connection can't go on
+            size_t bytes = 0;
+            if (!parseInt(argument, bytes)) {
+                sendAll(fd, "error Bad payload length\n");
+                return false;
+            }
+            if (!reader.read(payload, bytes)) return false;
+        } else if (kind == "path") {
+            if (::stat(argument.c_str(), &info) != 0 ||
+                !S_ISREG(info.st_mode) || ::access(argument.c_str(), R_OK))
+                error = "Coudn't find input file";
+        } else {
+            error = "Expected path or inline";
+        }
+        if (error.empty() && (part < 0 || part > 2))
+            error = "Part must be 0, 1 or 2";
+        if (error.empty() && solver == nullptr) error = "Not serving that day";
+
+        int64_t parseNs = 0, part1Ns = 0, part2Ns = 0;
+        out.str("");
+        out.clear();
+        if (error.empty()) {
+            arena.reset();
+            ArenaScope scope(arena);
+            try {
+                Clock::time_point start = Clock::now();
+                Input input = kind == "inline" ? Input::borrow(payload)
+                                               : Input(argument);
+                std::unique_ptr<Model> model = solver->parse(input, "");
+                parseNs = elapsedNs(start, Clock::now());
+
+                if (part != 2) {
+                    start = Clock::now();
+                    out << solver->solve(*model, 1, connection.workspaces[0]);
+                    part1Ns = elapsedNs(start, Clock::now());
+                }
+                if (part != 1) {
+                    start = Clock::now();
+                    out << solver->solve(*model, 2, connection.workspaces[1]);
+                    part2Ns = elapsedNs(start, Clock::now());
+                }
+            } catch (const std::exception& failure) {
+                error = std::string("Failed: ") + failure.what();
+            }
+        }
+
+        if (!error.empty()) return sendAll(fd, "error " + error + "\n");
+
+        std::string answers = out.str();
+        std::string reply = "ok " + std::to_string(parseNs) + " " +
+                            std::to_string(part1Ns) + " " +
+                            std::to_string(part2Ns) + " " +
+                            std::to_string(answers.size()) + "\n";
+        return sendAll(fd, reply) && sendAll(fd, answers);
+    }
+
+    /**
+     * Read and answer one request sent to a day's own --serve
+     */
+    inline bool serveRequest(int fd, SocketReader& reader,
+                             const Solver& solver, Connection& connection) {
+        std::string header;
+        if (!reader.readLine(header)) return false;
+
+        std::istringstream fields(header);
+        return answerRequest(fd, reader, fields, &solver, connection);
+    }
+
+    /**
+     * Stay resident and solve requests sent over a Unix socket, so callers
+     * that solve many small inputs skip process start-up every time. Each
+     * connection gets its own thread, which serves every request sent on it.
+     */
+    inline int serve(const Options& options, const Solver& solver) {
+        int listener = listenUnix(options.serveSocket);
+        if (listener < 0) {
+            std::cout << "Couldn't listen on " << options.serveSocket << ": "
+                      << std::strerror(errno) << "\n";
+            return 1;
+        }
+
+        while (true) {
+            int client = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                std::cout << "Couldn't accept: " << std::strerror(errno)
+                          << "\n";
+                ::close(listener);
+                return 1;
+            }
+
+            std::thread([client, &solver] {
+                SocketReader reader(client);
+                Connection connection;
+                while (serveRequest(client, reader, solver, connection))
+                    ;
+                ::close(client);
+            }).detach();
+        }
+    }
+
+    /**
+     * Write what the instrumentation recorded, if it was built in
+     */
+    inline bool writeStats(const Options& options) {
+#ifdef AOC_INSTRUMENT
+        if (options.statsFile.empty()) {
+            instrument::writeJson(std::cerr);
+            return true;
+        }
+        std::ofstream file(options.statsFile);
+        if (!file) {
+            std::cout << "Couldn't write " << options.statsFile << "\n";
+            return false;
+        }
+        instrument::writeJson(file);
+        return true;
+#else
+        if (options.statsFile.empty()) return true;
+        std::cout << "--stats needs a build with INSTRUMENT=1\n";
+        return false;
+#endif
+    }
+
+    /**
+     * Solve each part twice over one parsed model and fail if the second
+     * solve allocates anything on the heap. The first solve is the warm-up
+     * that starts the reduction pool and grows the part's scratch space in
+     * the workspace both solves share; from then on a part should run in
+     * the memory it already has, so an allocation here is a copy or a
+     * temporary that crept back into a hot loop.
+     *
+     * Allocations are only counted in instrumented builds.
+     */
+    inline int checkAllocations(const Options& options, const Solver& solver) {
+#ifdef AOC_INSTRUMENT
+        Arena arena;
+        ArenaScope scope(arena);
+        Input input(options.inputFile);
+        std::unique_ptr<Model> model = solver.parse(input, "");
+
+        const instrument::Allocations& heap = instrument::allocations();
+        bool ok = true;
+        for (int part = 1; part <= 2; part++) {
+            if (options.part != 0 && part != options.part) continue;
+            int phase = part == 1 ? instrument::PART1 : instrument::PART2;
+
+            Workspace workspace;
+            volatile int64_t answer =
+                solver.solve(*model, part, workspace).value;
+            uint64_t count = heap.count[phase].load();
+            uint64_t bytes = heap.bytes[phase].load();
+            answer = solver.solve(*model, part, workspace).value;
+            (void)answer;
+            count = heap.count[phase].load() - count;
+            bytes = heap.bytes[phase].load() - bytes;
+
+            std::cout << "Part " << part << ": ";
+            if (count == 0)
+                std::cout << "no allocations";
+            else
+                std::cout << count << " allocation(s), " << bytes
+                          << " bytes";
+            std::cout << " solving again\n";
+            ok = ok && count == 0;
+        }
+        return ok ? 0 : 1;
+#else
+        (void)solver;
+        (void)options;
+        std::cout << "--check-allocations needs a build with INSTRUMENT=1\n";
+        return 1;
+#endif
+    }
+
+    /**
+     * Pick the mode the options ask for and run it
+     */
+    inline int solve(const Options& options, const Solver& solver) {
+        if (options.checkAllocations) return checkAllocations(options, solver);
+        if (options.benchReps > 0) return bench(options, solver);
+        if (options.batch)
+            return batch(options,
+                         [&](const std::string&) { return &solver; });
+        if (!options.serveSocket.empty()) return serve(options, solver);
+
+        if (options.stream) {
+            if (!solver.canStream()) {
+                std::cout << "This day can't be solved as a stream\n";
+                return 1;
+            }
+            int fd = openInput(options.inputFile);
+            LineStream lines(fd);
+            solver.stream(lines, std::cout);
+            if (fd != STDIN_FILENO) ::close(fd);
+            return 0;
+        }
+
+        Arena arena;
+        ArenaScope scope(arena);
+        Input input(options.inputFile);
+        std::unique_ptr<Model> model =
+            solver.parse(input, modelCachePath(options, options.inputFile));
+
+        runParts(solver, *model, options, std::cout);
+        return 0;
+    }
+
+    /**
+     * main() for a day: parse the input once, then solve both parts
+     */
+    inline int run(int argc, char** argv, const Solver& solver) {
+        Options options;
+        if (!parseOptions(argc, argv, options)) return 1;
+        setReduceJobs(options.jobs);
+
+        int status = 1;
+        try {
+            status = solve(options, solver);
+        } catch (const InputError& error) {
+            std::cout << error.what() << "\n";
+        } catch (const std::exception& error) {
+            std::cout << "Failed: " << error.what() << "\n";
+        }
+        if (!writeStats(options)) return 1;
+        return status;
+    }
+}  // namespace aoc
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace aoc {
+    /**
+     * Unix domain stream sockets for the solver daemon (--serve and serve/).
+     *
+     * Requests and replies are a header line followed by a raw payload whose
+     * length the header gives, so binary input never needs escaping:
+     *
+     *     request    [<day>] <part> path <file>\n
+     *                [<day>] <part> inline <bytes>\n<payload>
+     *     reply      ok <parse ns> <part1 ns> <part2 ns> <bytes>\n<output>
+     *                error <message>\n
+     *
+     * The day is only sent to serve/, which solves every day itself; a
+     * day's own --serve takes requests without it. Part 0 solves both
+     * parts. An inline request whose length can't be read gets its error
+     * and then the connection closes, as its payload can't be skipped.
+     */
+    inline bool fillAddress(const std::string& path, sockaddr_un& address) {
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) return false;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    /**
+     * Listening socket at path, replacing a stale one. -1 on failure, with
+     * errno set.
+     */
+    inline int listenUnix(const std::string& path) {
+        sockaddr_un address;
+        if (!fillAddress(path, address)) {
+            errno = ENAMETOOLONG;
+            return -1;
+        }
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        ::unlink(path.c_str());
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&address),
+                   sizeof(address)) != 0 ||
+            ::listen(fd, 64) != 0) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            return -1;
+        }
+        return fd;
+    }
+
+    inline int connectUnix(const std::string& path) {
+        sockaddr_un address;
+        if (!fillAddress(path, address)) {
+            errno = ENAMETOOLONG;
+            return -1;
+        }
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&address),
+                      sizeof(address)) != 0) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            return -1;
+        }
+        return fd;
+    }
+
+    /**
+     * send() everything, without raising SIGPIPE if the peer has gone
+     */
+    inline bool sendAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t sent = ::send(fd, data, size, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += sent;
+            size -= sent;
+        }
+        return true;
+    }
+
+    inline bool sendAll(int fd, const std::string& data) {
+        return sendAll(fd, data.data(), data.size());
+    }
+
+    /**
+     * Buffered reads of header lines and the payloads that follow them. The
+     * buffer is kept across messages, so a connection that sends many
+     * requests stops allocating once it has seen the largest one.
+     */
+    class SocketReader {
+    public:
+        explicit SocketReader(int fd) : _fd(fd), _buffer(64 * 1024) {}
+
+        /**
+         * Next line without its '\n'. False at end of stream or on error.
+         */
+        bool readLine(std::string& line) {
+            while (true) {
+                const char* start = _buffer.data() + _start;
+                const void* found = std::memchr(start, '\n', _end - _start);
+                if (found != nullptr) {
+                    size_t length = static_cast<const char*>(found) - start;
+                    line.assign(start, length);
+                    _start += length + 1;
+                    return true;
+                }
+                if (!fill()) return false;
+            }
+        }
+
+        /**
+         * Exactly size bytes into out
+         */
+        bool read(std::string& out, size_t size) {
+            out.clear();
+            while (out.size() < size) {
+                if (_start == _end && !fill()) return false;
+                size_t take = std::min(size - out.size(), _end - _start);
+                out.append(_buffer.data() + _start, take);
+                _start += take;
+            }
+            return true;
+        }
+
+    private:
+        bool fill() {
+            if (_start > 0) {
+                std::memmove(_buffer.data(), _buffer.data() + _start,
+                             _end - _start);
+                _end -= _start;
+                _start = 0;
+            }
+            if (_end == _buffer.size()) _buffer.resize(_buffer.size() * 2);
+
+            while (true) {
+                ssize_t got = ::recv(_fd, _buffer.data() + _end,
+                                     _buffer.size() - _end, 0);
+                if (got > 0) {
+                    _end += got;
+                    return true;
+                }
+                if (got < 0 && errno == EINTR) continue;
+                return false;
+            }
+        }
+
+        int _fd;
+        std::vector<char> _buffer;
+        size_t _start = 0;
+        size_t _end = 0;
+    };
+}  // namespace aoc
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "input.h"
+#include "instrument.h"
+#include "model_cache.h"
+
+/**
+ * Every day behind one interface: parse an input into a model, then solve
+ * either part of that model for a typed answer.
+ *
+ * A day builds its solver from its own functions,
+ *
+ *     const auto daySolver = aoc::makeSolver(parse, part1, part2);
+ *
+ * where parse(const Input&) returns the day's model and part1 and part2
+ * take that model and return an Answer. A part that needs room to work in
+ * takes a second parameter, a reference to a scratch type of its own, and
+ * is handed the one kept in the caller's Workspace. The runner, the
+ * benchmark harness, the daemon and the multi-day binary in solve/ all work
+ * through Solver, so they can call any day in-process. Each day hands its
+ * solver out from dayNN::solver(), and common/days.h collects them.
+ */
+
+namespace aoc {
+    /**
+     * One part's answer, and the words a day prints in front of it
+     */
+    struct Answer {
+        const char* label = "";
+        int64_t value = 0;
+
+        Answer() = default;
+
+        template <typename T>
+        Answer(const char* text, T number)
+            : label(text), value(static_cast<int64_t>(number)) {
+            static_assert(std::is_integral_v<T>);
+        }
+    };
+
+    /**
+     * The answer as the day's line of output
+     */
+    inline std::ostream& operator<<(std::ostream& out, const Answer& answer) {
+        return out << answer.label << answer.value << "\n";
+    }
+
+    /**
+     * Scratch space for solving parts, owned by whoever calls solve(). A
+     * part with a scratch parameter gets the one kept here, made the first
+     * time it's asked for, so a caller that keeps a Workspace between
+     * solves lets a part reuse what it grew last time, and one that drops
+     * it gives that memory back. Parts solved at once need a Workspace
+     * each.
+     */
+    class Workspace {
+    public:
+        template <typename Scratch>
+        Scratch& get() {
+            if (Scratch* kept = std::any_cast<Scratch>(&_kept)) return *kept;
+            return _kept.emplace<Scratch>();
+        }
+
+    private:
+        std::any _kept;
+    };
+
+    /**
+     * A parsed input, only readable by the solver that parsed it
+     */
+    class Model {
+    public:
+        virtual ~Model() = default;
+    };
+
+    class Solver {
+    public:
+        virtual ~Solver() = default;
+
+        /**
+         * Parse input, through the model cache at cachePath when the day
+         * has one and cachePath isn't empty (see model_cache.h)
+         */
+        virtual std::unique_ptr<Model> parse(
+            const Input& input, const std::string& cachePath) const = 0;
+
+        /**
+         * Part 1 or 2 of a model from parse(). The model is only read, so
+         * both parts can be solved at once, each with its own workspace.
+         */
+        virtual Answer solve(const Model& model, int part,
+                             Workspace& workspace) const = 0;
+
+        /**
+         * A part solved once, with scratch space only for this solve
+         */
+        Answer solve(const Model& model, int part) const {
+            Workspace workspace;
+            return solve(model, part, workspace);
+        }
+
+        /**
+         * Whether the day can be solved a line at a time, see makeSolver()
+         */
+        virtual bool canStream() const = 0;
+        virtual void stream(LineStream& lines, std::ostream& out) const = 0;
+    };
+
+    /**
+     * The scratch type a part takes after its model, or void for a part
+     * that takes the model alone
+     */
+    template <typename PartType>
+    struct partScratch {
+        using type = void;
+    };
+
+    template <typename ModelType, typename Scratch>
+    struct partScratch<Answer (*)(const ModelType&, Scratch&)> {
+        using type = Scratch;
+    };
+
+    template <typename ParseType, typename Part1Type, typename Part2Type,
+              typename StreamType>
+    class DaySolver : public Solver {
+    public:
+        using Solver::solve;
+
+        using ModelType = std::decay_t<decltype(
+            std::declval<const ParseType&>()(std::declval<const Input&>()))>;
+
+        DaySolver(ParseType parse, Part1Type part1, Part2Type part2,
+                  StreamType stream)
+            : _parse(parse), _part1(part1), _part2(part2), _stream(stream) {}
+
+        /**
+         * The day's own model, for callers that know which day this is
+         */
+        ModelType parseModel(const Input& input,
+                             const std::string& cachePath = "") const {
+            AOC_PHASE(instrument::PARSE);
+            if constexpr (isCachedParse<ParseType>::value) {
+                if (!cachePath.empty())
+                    return parseCached(input, _parse, cachePath);
+            }
+            return _parse(input);
+        }
+
+        Answer solveModel(const ModelType& model, int part,
+                          Workspace& workspace) const {
+            if (part == 1) {
+                AOC_PHASE(instrument::PART1);
+                return solvePart(_part1, model, workspace);
+            }
+            AOC_PHASE(instrument::PART2);
+            return solvePart(_part2, model, workspace);
+        }
+
+        std::unique_ptr<Model> parse(
+            const Input& input, const std::string& cachePath) const override {
+            return std::make_unique<Parsed>(parseModel(input, cachePath));
+        }
+
+        Answer solve(const Model& model, int part,
+                     Workspace& workspace) const override {
+            return solveModel(static_cast<const Parsed&>(model).value, part,
+                              workspace);
+        }
+
+        bool canStream() const override {
+            return !std::is_same_v<StreamType, std::nullptr_t>;
+        }
+
+        void stream(LineStream& lines, std::ostream& out) const override {
+            if constexpr (!std::is_same_v<StreamType, std::nullptr_t>)
+                _stream(lines, out);
+        }
+
+    private:
+        template <typename PartType>
+        static Answer solvePart(const PartType& part, const ModelType& model,
+                                Workspace& workspace) {
+            using Scratch = typename partScratch<PartType>::type;
+            if constexpr (std::is_void_v<Scratch>)
+                return part(model);
+            else
+                return part(model, workspace.get<Scratch>());
+        }
+
+        struct Parsed : Model {
+            explicit Parsed(ModelType model) : value(std::move(model)) {}
+            ModelType value;
+        };
+
+        ParseType _parse;
+        Part1Type _part1;
+        Part2Type _part2;
+        StreamType _stream;
+    };
+
+    /**
+     * A day's solver. Days whose answers can be built up a line at a time
+     * also pass stream, called as stream(LineStream&, std::ostream&) for
+     * --stream; it has to print the same lines as the parts' answers, from
+     * one pass and in bounded memory.
+     */
+    template <typename ParseType, typename Part1Type, typename Part2Type,
+              typename StreamType = std::nullptr_t>
+    DaySolver<ParseType, Part1Type, Part2Type, StreamType> makeSolver(
+        ParseType parse, Part1Type part1, Part2Type part2,
+        StreamType stream = nullptr) {
+        return {parse, part1, part2, stream};
+    }
+}  // namespace aoc
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+    /**
+     * Fixed set of worker threads with one queue of task indices each.
+     * parallelFor() deals the indices out round robin; a worker takes from
+     * the back of its own queue and, once that runs dry, steals from the
+     * front of someone else's, so one slow task doesn't hold up the ones
+     * queued behind it. The calling thread works too, so a pool of one
+     * thread runs everything inline.
+     *
+     * Dealing round robin means queue q holds q, q + size(), q + 2 size()
+     * and so on, so a queue is just the range of those steps still left,
+     * and parallelFor() never allocates.
+     */
+    class ThreadPool {
+    public:
+        explicit ThreadPool(unsigned threads = 0) {
+            if (threads == 0)
+                threads = std::max(1u, std::thread::hardware_concurrency());
+
+            for (unsigned i = 0; i < threads; i++)
+                _queues.push_back(std::make_unique<Queue>());
+            for (unsigned i = 1; i < threads; i++)
+                _workers.emplace_back([this, i] { workerLoop(i); });
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _wake.notify_all();
+            for (auto& worker : _workers) worker.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t size() const { return _queues.size(); }
+
+        /**
+         * Call fn(i) for every i in [0, count) and return once all calls
+         * are done. If a call throws, the other calls still run and the
+         * first exception is thrown again from here once they're done. Only
+         * one parallelFor() may run on a pool at a time.
+         */
+        template <typename Fn>
+        void parallelFor(size_t count, Fn fn) {
+            if (count == 0) return;
+
+            _task = &fn;
+            _run = [](const void* task, size_t index) {
+                (*static_cast<const Fn*>(task))(index);
+            };
+            _remaining = count;
+            size_t queues = _queues.size();
+            for (size_t q = 0; q < queues; q++) {
+                Queue& queue = *_queues[q];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.front = 0;
+                queue.back = q < count ? (count - q + queues - 1) / queues : 0;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _generation++;
+            }
+            _wake.notify_all();
+
+            work(0);
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this] { return _remaining == 0; });
+            _task = nullptr;
+            if (_error) std::rethrow_exception(std::exchange(_error, {}));
+        }
+
+    private:
+        /**
+         * Steps [front, back) of a queue are left, step k being the index
+         * queue + k * size()
+         */
+        struct Queue {
+            std::mutex mutex;
+            size_t front = 0;
+            size_t back = 0;
+        };
+
+        bool take(unsigned self, size_t& index) {
+            size_t queues = _queues.size();
+            {
+                Queue& own = *_queues[self];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (own.front < own.back) {
+                    index = self + --own.back * queues;
+                    return true;
+                }
+            }
+
+            for (size_t step = 1; step < queues; step++) {
+                size_t other = (self + step) % queues;
+                Queue& victim = *_queues[other];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.front < victim.back) {
+                    index = other + victim.front++ * queues;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void work(unsigned self) {
+            size_t index;
+            while (take(self, index)) {
+                try {
+                    _run(_task, index);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!_error) _error = std::current_exception();
+                }
+                if (--_remaining == 0) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _done.notify_all();
+                }
+            }
+        }
+
+        void workerLoop(unsigned self) {
+            uint64_t seen = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _wake.wait(lock, [&] {
+                        return _stopping || _generation != seen;
+                    });
+                    if (_stopping) return;
+                    seen = _generation;
+                }
+                work(self);
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue>> _queues;
+        std::vector<std::thread> _workers;
+
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _done;
+        uint64_t _generation = 0;
+        bool _stopping = false;
+
+        // the running parallelFor()'s fn, and how to call it
+        const void* _task = nullptr;
+        void (*_run)(const void* task, size_t index) = nullptr;
+        std::atomic<size_t> _remaining {0};
+        // the first exception a call threw, guarded by _mutex
+        std::exception_ptr _error;
+    };
+}  // namespace aoc
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+    /**
+     * Token buffer owned by the caller. Keep one around across lines so its
+     * capacity is reused and tokenizing stops allocating after the first few
+     * lines.
+     */
+    using Tokens = std::vector<std::string_view>;
+
+    /**
+     * Split line on any of the characters in delimiters. The tokens are views
+     * into line, so they are only valid for as long as line is.
+     *
+     * Empty tokens between neighbouring delimiters are skipped unless
+     * keepEmpty is set, in which case the split matches std::getline: a
+     * leading delimiter gives an empty first token but a trailing one doesn't
+     * give an empty last token.
+     */
+    inline void tokenize(std::string_view line, Tokens& tokens,
+                         std::string_view delimiters = " ",
+                         bool keepEmpty = false) {
+        tokens.clear();
+
+        size_t start = 0;
+        while (start < line.size()) {
+            size_t end = line.find_first_of(delimiters, start);
+            if (end == std::string_view::npos) end = line.size();
+
+            if (keepEmpty || end > start)
+                tokens.push_back(line.substr(start, end - start));
+
+            start = end + 1;
+        }
+    }
+}  // namespace aoc
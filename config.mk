@@ -0,0 +1,51 @@
+# Compiler flags shared by the top-level Makefile and every day's Makefile.
+# Pick a configuration with CONFIG=debug|release|lto|native|profile (default
+# debug). profile is optimized like release but keeps debug info and frame
+# pointers, so perf can walk and name the stacks of optimized code.
+# pgo-gen and pgo are the two halves of 'make pgo' in the top-level Makefile.
+
+ROOT := $(dir $(lastword $(MAKEFILE_LIST)))
+
+CC = g++
+CONFIG ?= debug
+
+BASE_FLAGS = -std=c++17 -pthread
+RELEASE_FLAGS = $(BASE_FLAGS) -O3 -DNDEBUG
+
+# gcc names each profile after the working directory, so the instrumented
+# and optimized builds must both run from the top level
+PGO_DATA = $(abspath $(ROOT)build/pgo-data)
+
+ifeq ($(CONFIG),debug)
+  FLAGS = $(BASE_FLAGS) -g -O0
+else ifeq ($(CONFIG),release)
+  FLAGS = $(RELEASE_FLAGS)
+else ifeq ($(CONFIG),lto)
+  FLAGS = $(RELEASE_FLAGS) -flto=auto
+else ifeq ($(CONFIG),native)
+  FLAGS = $(RELEASE_FLAGS) -march=native
+else ifeq ($(CONFIG),profile)
+  FLAGS = $(BASE_FLAGS) -O2 -DNDEBUG -g -fno-omit-frame-pointer \
+          -mno-omit-leaf-frame-pointer
+else ifeq ($(CONFIG),pgo-gen)
+  FLAGS = $(RELEASE_FLAGS) -fprofile-generate=$(PGO_DATA) \
+          -fprofile-update=atomic
+else ifeq ($(CONFIG),pgo)
+  FLAGS = $(RELEASE_FLAGS) -fprofile-use=$(PGO_DATA) -fprofile-correction \
+          -Wno-missing-profile
+else
+  $(error Unknown CONFIG '$(CONFIG)', use debug, release, lto, native or \
+    profile)
+endif
+
+# INSTRUMENT=1 turns on the counters and timers in common/instrument.h
+ifeq ($(INSTRUMENT),1)
+  FLAGS += -DAOC_INSTRUMENT
+endif
+
+COMMON = $(wildcard $(ROOT)common/*.h)
+
+# every day's header and solver, which the tools built on common/days.h
+# include and link in
+DAY_HEADERS = $(wildcard $(ROOT)day[0-9][0-9]/day.h)
+DAY_SOURCES = $(wildcard $(ROOT)day[0-9][0-9]/day.cpp)
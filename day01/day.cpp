@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../common/input.h"
+#include "../common/parallel.h"
+#include "../common/parse_int.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "day.h"
+
+namespace day01 {
+
+// one calibration value per line; the lines are independent, so the parts
+// split the input across cores themselves
+using calibrationDocument = std::string_view;
+
+calibrationDocument parse(const aoc::Input &input) { return input.data(); }
+
+/**
+ * First and last digit on the line. first and last are carried over from
+ * the previous line, so a line without digits repeats its value.
+ */
+int calibrationValue(std::string_view line, char &first, char &last) {
+  bool foundFirst = false;
+
+  for (auto &ch : line) {
+    if (std::isdigit(ch)) {
+      if (!foundFirst) {
+        first = ch;
+        foundFirst = true;
+      }
+
+      last = ch;
+    }
+  }
+  return (first - '0') * 10 + (last - '0');
+}
+
+/**
+ * First and last digit on the line, where digits can be spelled out
+ */
+int calibrationValueWithWords(std::string_view line) {
+  static const std::unordered_map<std::string, std::string> wordToDigit = {
+      {"one", "1"},   {"two", "2"},   {"three", "3"},
+      {"four", "4"},  {"five", "5"},  {"six", "6"},
+      {"seven", "7"}, {"eight", "8"}, {"nine", "9"},
+  };
+
+  std::string first, last;
+  int firstPos, lastPos;
+  firstPos = -1;
+  lastPos = -1;
+  size_t posWord = 0;
+  size_t posDigit = 0;
+
+  for (auto &keypair : wordToDigit) {
+    posWord = line.find(keypair.first);
+    posDigit = line.find(keypair.second);
+
+    if (posWord != std::string::npos) {
+      if (firstPos == -1) {
+        firstPos = posWord;
+        first = keypair.second;
+      } else if (posWord < firstPos) {
+        firstPos = posWord;
+        first = keypair.second;
+      }
+    }
+
+    if (posDigit != std::string::npos) {
+      if (firstPos == -1) {
+        firstPos = posDigit;
+        first = keypair.second;
+      } else if (posDigit < firstPos) {
+        firstPos = posDigit;
+        first = keypair.second;
+      }
+    }
+    posDigit = line.rfind(keypair.second);
+    posWord = line.rfind(keypair.first);
+    if (posWord != std::string::npos) {
+      if (lastPos == -1) {
+        lastPos = posWord;
+        last = keypair.second;
+      } else if (posWord > lastPos) {
+        lastPos = posWord;
+        last = keypair.second;
+      }
+    }
+
+    if (posDigit != std::string::npos) {
+      if (lastPos == -1) {
+        lastPos = posDigit;
+        last = keypair.second;
+      } else if (posDigit > lastPos) {
+        lastPos = posDigit;
+        last = keypair.second;
+      }
+    }
+  } // for
+
+  return aoc::toInt<int>(first) * 10 + aoc::toInt<int>(last);
+}
+
+/**
+ * A chunk's running sum. A line without digits repeats the line before
+ * it, which for the ones at the start of a chunk is in another chunk, so
+ * those are only counted until the chunks are combined.
+ */
+struct calibrationSum {
+  int64_t sum = 0;
+  // lines without digits before the chunk's first line with some
+  int64_t leading = 0;
+  bool foundDigits = false;
+  char first{};
+  char last{};
+};
+
+aoc::Answer part1(const calibrationDocument &document) {
+  calibrationSum total = aoc::reduceLines(
+      document, calibrationSum{},
+      [](calibrationSum &chunk, std::string_view line) {
+        if (!chunk.foundDigits) {
+          if (std::none_of(line.begin(), line.end(),
+                           [](char ch) { return std::isdigit(ch); })) {
+            chunk.leading++;
+            return;
+          }
+          chunk.foundDigits = true;
+        }
+        chunk.sum += calibrationValue(line, chunk.first, chunk.last);
+      },
+      [](calibrationSum &all, const calibrationSum &chunk) {
+        all.sum += chunk.sum +
+                   chunk.leading * calibrationValue({}, all.first, all.last);
+        if (chunk.foundDigits) {
+          all.foundDigits = true;
+          all.first = chunk.first;
+          all.last = chunk.last;
+        }
+      });
+
+  // the first chunk's leading lines come before any digits at all
+  char none{};
+  total.sum += total.leading * calibrationValue({}, none, none);
+  return {"Part 1: Sum of calibration values is ", total.sum};
+}
+
+aoc::Answer part2(const calibrationDocument &document) {
+  int64_t sum = aoc::reduceLines(
+      document, int64_t{0},
+      [](int64_t &chunk, std::string_view line) {
+        chunk += calibrationValueWithWords(line);
+      },
+      [](int64_t &all, int64_t chunk) { all += chunk; });
+
+  return {"Part 2: Sum of calibration values is ", sum};
+}
+
+/**
+ * Both parts in one pass over lines as they are read
+ */
+void stream(aoc::LineStream &lines, std::ostream &out) {
+  char first{};
+  char last{};
+
+  int64_t sum1 = 0;
+  int64_t sum2 = 0;
+  std::string_view line;
+  while (lines.next(line)) {
+    sum1 += calibrationValue(line, first, last);
+    sum2 += calibrationValueWithWords(line);
+  }
+
+  out << aoc::Answer("Part 1: Sum of calibration values is ", sum1);
+  out << aoc::Answer("Part 2: Sum of calibration values is ", sum2);
+}
+
+const auto daySolver = aoc::makeSolver(parse, part1, part2, stream);
+
+const aoc::Solver &solver() { return daySolver; }
+
+} // namespace day01
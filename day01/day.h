@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day 1: Trebuchet?!
+ */
+namespace day01 {
+  const aoc::Solver &solver();
+} // namespace day01
@@ -0,0 +1,234 @@
+#include <cctype>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input.h"
+#include "../common/parallel.h"
+#include "../common/parse_int.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "day.h"
+
+namespace day02 {
+
+/*
+ * Cubes revealed in one handful. A game's handfuls are stored back to back
+ * in gameRecord::sets.
+ */
+struct cubeSet {
+  int red = 0;
+  int green = 0;
+  int blue = 0;
+};
+
+struct game {
+  int id;
+  size_t firstSet;
+  size_t setCount;
+};
+
+struct gameRecord {
+  std::vector<game> games;
+  std::vector<cubeSet> sets;
+};
+
+// games per chunk when the parts split the record across cores
+const size_t GAME_CHUNK = 1 << 16;
+
+gameRecord parse(const aoc::Input &input);
+game parseGame(std::string_view line, std::vector<cubeSet> &sets);
+void parseSets(std::string_view line, std::vector<cubeSet> &sets);
+
+aoc::Answer part1(const gameRecord &record);
+bool isPossible(const gameRecord &record, const game &g);
+
+aoc::Answer part2(const gameRecord &record);
+int getPower(const gameRecord &record, const game &g);
+
+void stream(aoc::LineStream &lines, std::ostream &out);
+
+const auto daySolver = aoc::makeSolver(parse, part1, part2, stream);
+
+const aoc::Solver &solver() { return daySolver; }
+
+/*
+ * Parsing
+ */
+gameRecord parse(const aoc::Input &input) {
+  // games are parsed a chunk of lines at a time across cores, then each
+  // chunk is appended in order with its games pointed past the sets before
+  return aoc::reduceLines(
+      input.data(), gameRecord{},
+      [](gameRecord &chunk, std::string_view line) {
+        chunk.games.push_back(parseGame(line, chunk.sets));
+      },
+      [](gameRecord &record, const gameRecord &chunk) {
+        size_t offset = record.sets.size();
+        record.sets.insert(record.sets.end(), chunk.sets.begin(),
+                           chunk.sets.end());
+        for (game g : chunk.games) {
+          g.firstSet += offset;
+          record.games.push_back(g);
+        }
+      });
+}
+
+/*
+ * Read one game, appending its handfuls to sets
+ */
+game parseGame(std::string_view line, std::vector<cubeSet> &sets) {
+  game g{};
+  // Game X..
+  // 012345
+  aoc::parseIntPrefix(line.substr(5), g.id);
+  g.firstSet = sets.size();
+  parseSets(line, sets);
+  g.setCount = sets.size() - g.firstSet;
+  return g;
+}
+
+void parseSets(std::string_view line, std::vector<cubeSet> &sets) {
+  cubeSet set;
+
+  int count = 0;
+  for (size_t i = line.find(":"); i < line.size(); i++) {
+    if (line[i] == ';') {
+      sets.push_back(set);
+      set = cubeSet();
+    }
+    if (std::isdigit(line[i])) {
+      size_t digits = aoc::parseIntPrefix(line.substr(i), count);
+      if (digits == 0) // too big to be a cube count
+        break;
+      i += digits - 1; // the loop steps past the last digit
+    } else if (count > 0 && line[i] == 'b') {
+      set.blue += count;
+      count = 0;
+    } else if (count > 0 && line[i] == 'r') {
+      set.red += count;
+      count = 0;
+    } else if (count > 0 && line[i] == 'g') {
+      set.green += count;
+      count = 0;
+    }
+  }
+
+  // lines don't end in ; so the last set is still open
+  sets.push_back(set);
+}
+
+/*
+ * Part 1
+ *
+ * Example 1:
+ * Game 1: 3 blue, 4 red; 1 red, 2 green, 6 blue; 2 green
+ * Game 2: 1 blue, 2 green; 3 green, 4 blue, 1 red; 1 green, 1 blue
+ * Game 3: 8 green, 6 blue, 20 red; 5 blue, 4 red, 13 green; 5 green, 1 red
+ * Game 4: 1 green, 3 red, 6 blue; 3 green, 6 red; 3 green, 15 blue, 14 red
+ * Game 5: 6 red, 1 blue, 3 green; 2 blue, 1 red, 2 green
+ *
+ * possible if bag only contained 12 red cubes, 13 green cubes, and 14 blue
+ * cubes
+ *
+ * In example 1, games 1, 2, and 5 are possible
+ *
+ */
+aoc::Answer part1(const gameRecord &record) {
+  int sum = aoc::parallelReduce(
+      record.games.size(), GAME_CHUNK, 0,
+      [&](int &chunk, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          if (isPossible(record, record.games[i]))
+            chunk += record.games[i].id;
+        }
+      },
+      [](int &all, int chunk) { all += chunk; });
+  return {"Part 1: Sum of possible games is ", sum};
+}
+
+/*
+ * part 1 helper methods
+ */
+bool isPossible(const gameRecord &record, const game &g) {
+  const int RED_LIMIT = 12;
+  const int BLUE_LIMIT = 14;
+  const int GREEN_LIMIT = 13;
+
+  for (size_t i = g.firstSet; i < g.firstSet + g.setCount; i++) {
+    const cubeSet &set = record.sets[i];
+    if ((set.red > RED_LIMIT) || (set.blue > BLUE_LIMIT) ||
+        (set.green > GREEN_LIMIT)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Part 2
+ */
+aoc::Answer part2(const gameRecord &record) {
+  int sum = aoc::parallelReduce(
+      record.games.size(), GAME_CHUNK, 0,
+      [&](int &chunk, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+          chunk += getPower(record, record.games[i]);
+      },
+      [](int &all, int chunk) { all += chunk; });
+
+  return {"Part 2: Sum of powers of games is ", sum};
+}
+
+/*
+ *  part 2 helper methods
+ */
+int getPower(const gameRecord &record, const game &g) {
+  int minRed = 0;
+  int minBlue = 0;
+  int minGreen = 0;
+
+  for (size_t i = g.firstSet; i < g.firstSet + g.setCount; i++) {
+    const cubeSet &set = record.sets[i];
+    if (minRed < set.red)
+      minRed = set.red;
+    if (minBlue < set.blue)
+      minBlue = set.blue;
+    if (minGreen < set.green)
+      minGreen = set.green;
+  }
+
+  return minRed * minBlue * minGreen;
+}
+
+/*
+ * Streaming
+ *
+ * Each game only needs its own handfuls, so the record holds one game at a
+ * time and both sums are kept as the lines go by
+ */
+void stream(aoc::LineStream &lines, std::ostream &out) {
+  gameRecord record;
+  int possibleSum = 0;
+  int powerSum = 0;
+
+  std::string_view line;
+  while (lines.next(line)) {
+    record.games.clear();
+    record.sets.clear();
+    record.games.push_back(parseGame(line, record.sets));
+
+    const game &g = record.games.front();
+    if (isPossible(record, g))
+      possibleSum += g.id;
+    powerSum += getPower(record, g);
+  }
+
+  out << aoc::Answer("Part 1: Sum of possible games is ", possibleSum);
+  out << aoc::Answer("Part 2: Sum of powers of games is ", powerSum);
+}
+
+} // namespace day02
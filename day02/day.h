@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day 2: Cube Conundrum
+ */
+namespace day02 {
+  const aoc::Solver &solver();
+} // namespace day02
@@ -0,0 +1,353 @@
+#include <cctype>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "../common/grid.h"
+#include "../common/input.h"
+#include "../common/parse_int.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "day.h"
+
+namespace day03 {
+
+// padded with '.', which is neither a digit nor a symbol
+using schematic = aoc::Grid2D<char>;
+
+/**
+ * The numbers read around a gear. It's scratch from the caller's
+ * workspace, so reading them again reuses the strings however long the
+ * numbers are.
+ */
+struct gearNumbers {
+  // at most two numbers above, two below and two beside
+  std::string possible[6];
+  std::string l;
+  std::string m;
+  std::string ri;
+};
+
+aoc::Answer part1(const schematic &schem, std::string &buildNumber);
+schematic loadSchematic(const aoc::Input &);
+void printSchematic(const schematic &schem);
+bool nextToSpecialSymbol(int, int, const schematic &);
+
+aoc::Answer part2(const schematic &schem, gearNumbers &numbers);
+bool nextToTwoPartNumbers(const schematic &, int, int);
+void lookAhead(const schematic &schem, int row, int col, std::string &result);
+void lookBack(const schematic &schem, int row, int col, std::string &result);
+
+const auto daySolver = aoc::makeSolver(loadSchematic, part1, part2);
+
+const aoc::Solver &solver() { return daySolver; }
+
+/*
+ *                        --- Day 3 Part 1: Gear Ratios ---
+ *
+ * You and the Elf eventually reach a gondola lift station; he says the gondola
+ * lift will take you up to the water source, but this is as far as he can bring
+ * you. You go inside.
+ *
+ * It doesn't take long to find the gondolas, but there seems to be a problem:
+ * they're not moving.
+ *
+ * "Aaah!"
+ *
+ * You turn around to see a slightly-greasy Elf with a wrench and a look of
+ * surprise. "Sorry, I wasn't expecting anyone! The gondola lift isn't working
+ * right now; it'll still be a while before I can fix it." You offer to help.
+ *
+ * The engineer explains that an engine part seems to be missing from the
+ * engine, but nobody can figure out which one. If you can add up all the part
+ * numbers in the engine schematic, it should be easy to work out which part is
+ * missing.
+ *
+ * The engine schematic (your puzzle input) consists of a visual representation
+ * of the engine. There are lots of numbers and symbols you don't really
+ * understand, but apparently any number adjacent to a symbol, even diagonally,
+ * is a "part number" and should be included in your sum. (Periods (.) do not
+ * count as a symbol.)
+ *
+ * Here is an example engine schematic:
+ *
+ * 467..114..
+ * ...*......
+ * ..35..633.
+ * ......#...
+ * 617*......
+ * .....+.58.
+ * ..592.....
+ * ......755.
+ * ...$.*....
+ * .664.598..
+ *
+ * In this schematic, two numbers are not part numbers because they are not
+ * adjacent to a symbol: 114 (top right) and 58 (middle right). Every other
+ * number is adjacent to a symbol and so is a part number; their sum is 4361.
+ *
+ * Of course, the actual engine schematic is much larger. What is the sum of all
+ * of the part numbers in the engine schematic?
+ *
+ */
+
+/**
+ * buildNumber is scratch from the caller's workspace
+ */
+aoc::Answer part1(const schematic &schem, std::string &buildNumber) {
+  buildNumber.clear();
+  bool valid = false;
+  int sum = 0;
+
+  int height = schem.height();
+  int width = schem.width();
+
+  for (int r = 0; r < height; r++) {
+    // check incase number was at end of line
+    if (buildNumber.size() > 0) { // we are done with current number
+      if (valid)
+        sum += aoc::toInt<int>(buildNumber);
+
+      buildNumber.clear();
+      valid = false;
+    }
+    for (int c = 0; c < width; c++) {
+      char ch = schem(r, c);
+
+      if (std::isdigit(ch)) {
+        buildNumber.push_back(ch);
+        if (nextToSpecialSymbol(r, c, schem))
+          valid = true;
+      } else if (buildNumber.size() > 0) { // we are done with current number
+        if (valid)
+          sum += aoc::toInt<int>(buildNumber);
+
+        buildNumber.clear();
+        valid = false;
+      }
+    }
+  }
+
+  // last check if number was at very end
+  if (valid && buildNumber.size() > 0)
+    sum += aoc::toInt<int>(buildNumber);
+
+  return {"Part 1: Sum of part numbers is ", sum};
+} // part1
+
+/*
+ * part 1 helper methods
+ */
+
+// .***.
+// .*2*.
+// .***.
+bool nextToSpecialSymbol(int r, int c, const schematic &schem) {
+
+  for (int row = r - 1; row < (r - 1) + 3; row++) {
+    for (int col = c - 1; col < (c - 1) + 3; col++) {
+      if (row == r && col == c)
+        continue;
+      char ch = schem(row, col);
+      if (!(std::isdigit(ch)) && ch != '.' && ch != ' ')
+        return true;
+    }
+  }
+  return false;
+}
+schematic loadSchematic(const aoc::Input &input) {
+  return aoc::readGrid(input, '.');
+}
+
+void printSchematic(const schematic &schem) {
+  for (int r = 0; r < schem.height(); r++) {
+    for (char ch : schem.row(r))
+      std::cout << ch;
+    std::cout << "\n";
+  }
+}
+
+/**
+ *                            --- Part Two ---
+ *
+ * The engineer finds the missing part and installs it in the engine! As the
+ * engine springs to life, you jump in the closest gondola, finally ready to
+ * ascend to the water source.
+ *
+ * You don't seem to be going very fast, though. Maybe something is still wrong?
+ * Fortunately, the gondola has a phone labeled "help", so you pick it up and
+ * the engineer answers.
+ *
+ * Before you can explain the situation, she suggests that you look out the
+ * window. There stands the engineer, holding a phone in one hand and waving
+ *with the other. You're going so slowly that you haven't even left the station.
+ *You exit the gondola.
+ *
+ * The missing part wasn't the only issue - one of the gears in the engine is
+ * wrong. A gear is any * symbol that is adjacent to exactly two part numbers.
+ *Its gear ratio is the result of multiplying those two numbers together.
+ *
+ * This time, you need to find the gear ratio of every gear and add them all up
+ *so that the engineer can figure out which gear needs to be replaced.
+ *
+ * Consider the same engine schematic again:
+ *
+ * 467..114..
+ * ...*......
+ * ..35..633.
+ * ......#...
+ * 617*......
+ * .....+.58.
+ * ..592.....
+ * ......755.
+ * ...$.*....
+ * .664.598..
+ *
+ * In this schematic, there are two gears. The first is in the top left; it has
+ * part numbers 467 and 35, so its gear ratio is 16345. The second gear is in
+ *the lower right; its gear ratio is 451490. (The * adjacent to 617 is not a
+ *gear because it is only adjacent to one part number.) Adding up all of the
+ *gear ratios produces 467835.
+ *
+ * What is the sum of all of the gear ratios in your engine schematic?
+ *
+ *
+ */
+
+aoc::Answer part2(const schematic &schem, gearNumbers &numbers) {
+  auto &possible = numbers.possible;
+  std::string &l = numbers.l;
+  std::string &m = numbers.m;
+  std::string &ri = numbers.ri;
+
+  int height = schem.height();
+  int width = schem.width();
+  int sum = 0;
+
+  for (int r = 0; r < height; r++) {
+    for (int c = 0; c < width; c++) {
+      char ch = schem(r, c);
+      // found potential gear!
+      if (ch == '*') {
+        if (nextToTwoPartNumbers(schem, r, c)) {
+          int ratio = 0;
+
+          for (auto &p : possible)
+            p.clear();
+          int found = 0;
+
+          lookBack(schem, r + 1, c - 1, l);
+          lookAhead(schem, r + 1, c, m);
+          lookAhead(schem, r + 1, c + 1, ri);
+
+          if (l.empty() && m.empty() && !ri.empty()) {
+            possible[found++] = ri;
+          } else if ((l.empty() && !m.empty() && ri.empty()) ||
+                     (l.empty() && !m.empty() && !ri.empty())) {
+            possible[found++] = m;
+          } else if (!l.empty() && m.empty() && ri.empty()) {
+            possible[found++] = l;
+          } else if (!l.empty() && m.empty() && !ri.empty()) {
+            possible[found++] = l;
+            possible[found++] = ri;
+          } else if (!l.empty() && !m.empty() && ri.empty()) {
+            possible[found] = l;
+            possible[found++] += m;
+          } else if (!l.empty() && !m.empty() && !ri.empty()) {
+            possible[found] = l;
+            possible[found++] += m;
+          }
+
+          lookBack(schem, r - 1, c - 1, l);
+          lookAhead(schem, r - 1, c, m);
+          lookAhead(schem, r - 1, c + 1, ri);
+
+          if (l.empty() && m.empty() && !ri.empty()) {
+            possible[found++] = ri;
+          } else if ((l.empty() && !m.empty() && ri.empty()) ||
+                     (l.empty() && !m.empty() && !ri.empty())) {
+            possible[found++] = m;
+          } else if (!l.empty() && m.empty() && ri.empty()) {
+            possible[found++] = l;
+          } else if (!l.empty() && m.empty() && !ri.empty()) {
+            possible[found++] = l;
+            possible[found++] = ri;
+          } else if (!l.empty() && !m.empty() && ri.empty()) {
+            possible[found] = l;
+            possible[found++] += m;
+          } else if (!l.empty() && !m.empty() && !ri.empty()) {
+            possible[found] = l;
+            possible[found++] += m;
+          }
+
+          lookBack(schem, r, c - 1, l);
+          lookAhead(schem, r, c + 1, ri);
+
+          if (!l.empty())
+            possible[found++] = l;
+          if (!ri.empty())
+            possible[found++] = ri;
+
+          for (auto &p : possible) {
+            if (!p.empty()) {
+              if (ratio == 0)
+                ratio = aoc::toInt<int>(p);
+              else
+                ratio *= aoc::toInt<int>(p);
+            }
+          }
+          sum += ratio;
+        }
+      }
+    }
+  }
+  return {"Part 2: Sum of gear ratios is ", sum};
+}
+void lookBack(const schematic &schem, int row, int col, std::string &result) {
+  result.clear();
+  while (isdigit(schem(row, col))) {
+    result.insert(0, 1, schem(row, col));
+    col--;
+  }
+}
+void lookAhead(const schematic &schem, int row, int col, std::string &result) {
+  result.clear();
+  while (isdigit(schem(row, col))) {
+    result.push_back(schem(row, col));
+    col++;
+  }
+}
+
+bool nextToTwoPartNumbers(const schematic &schem, int row, int col) {
+  int count = 0;
+
+  bool topLeft = isdigit(schem(row - 1, col - 1));
+  bool topMid = isdigit(schem(row - 1, col));
+  bool topRight = isdigit(schem(row - 1, col + 1));
+
+  bool midLeft = isdigit(schem(row, col - 1));
+  bool midRight = isdigit(schem(row, col + 1));
+
+  bool botLeft = isdigit(schem(row + 1, col - 1));
+  bool botMid = isdigit(schem(row + 1, col));
+  bool botRight = isdigit(schem(row + 1, col + 1));
+
+  if (topLeft && !topMid && topRight)
+    count += 2;
+  else if (!(!topLeft && !topMid && !topRight))
+    count += 1;
+
+  if (botLeft && !botMid && botRight)
+    count += 2;
+  else if (!(!botLeft && !botMid && !botRight))
+    count += 1;
+
+  if (midLeft)
+    count += 1;
+  if (midRight)
+    count += 1;
+
+  return count == 2;
+}
+
+} // namespace day03
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day 3: Gear Ratios
+ */
+namespace day03 {
+  const aoc::Solver &solver();
+} // namespace day03
@@ -0,0 +1,346 @@
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/arena.h"
+#include "../common/input.h"
+#include "../common/instrument.h"
+#include "../common/parallel.h"
+#include "../common/parse_int.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "../common/tokenize.h"
+#include "day.h"
+
+namespace day04 {
+
+// card number to its numbers, built in the run's arena
+using cardNumbers = std::pmr::map<int, std::pmr::set<int>>;
+
+struct scratchcards {
+  cardNumbers winning{aoc::arena()};
+  cardNumbers scratch{aoc::arena()};
+  // card numbers in the order they were read; each card scores on its own,
+  // so part 1 splits these across cores and looks each one up in the maps
+  std::pmr::vector<int> order{aoc::arena()};
+};
+
+// cards per chunk when part 1 splits them across cores
+const size_t CARD_CHUNK = 1 << 14;
+
+scratchcards parse(const aoc::Input &input);
+void parseNumbers(cardNumbers &w, cardNumbers &s, std::pmr::vector<int> &order,
+                  aoc::Lines &lines);
+int parseCard(std::string_view line, aoc::Tokens &tokens,
+              std::pmr::set<int> &winningNums,
+              std::pmr::set<int> &scratchNums);
+int countMatches(const std::pmr::set<int> &winningNums,
+                 const std::pmr::set<int> &scratchNums);
+
+aoc::Answer part1(const scratchcards &cards);
+
+aoc::Answer part2(const scratchcards &cards, std::vector<int> &save);
+int countCopies(int gameNumber, const cardNumbers &winning,
+                const cardNumbers &scratch, std::vector<int> &save);
+
+void stream(aoc::LineStream &lines, std::ostream &out);
+
+const auto daySolver = aoc::makeSolver(parse, part1, part2, stream);
+
+const aoc::Solver &solver() { return daySolver; }
+
+/**
+ *                    --- Day 4: Scratchcards ---
+ * The gondola takes you up. Strangely, though, the ground doesn't seem to be
+ * coming with you; you're not climbing a mountain. As the circle of Snow Island
+ * recedes below you, an entire new landmass suddenly appears above you! The
+ * gondola carries you to the surface of the new island and lurches into the
+ * station.
+ *
+ * As you exit the gondola, the first thing you notice is that the air here is
+ * much warmer than it was on Snow Island. It's also quite humid. Is this where
+ * the water source is?
+ *
+ * The next thing you notice is an Elf sitting on the floor across the station
+ * in what seems to be a pile of colorful square cards.
+ *
+ * "Oh! Hello!" The Elf excitedly runs over to you. "How may I be of service?"
+ * You ask about water sources.
+ *
+ * "I'm not sure; I just operate the gondola lift. That does sound like
+ * something we'd have, though - this is Island Island, after all! I bet the
+ * gardener would know. He's on a different island, though - er, the small kind
+ * surrounded by water, not the floating kind. We really need to come up with a
+ * better naming scheme. Tell you what: if you can help me with something quick,
+ * I'll let you borrow my boat and you can go visit the gardener. I got all
+ * these scratchcards as a gift, but I can't figure out what I've won."
+ *
+ * The Elf leads you over to the pile of colorful cards. There, you discover
+ * dozens of scratchcards, all with their opaque covering already scratched off.
+ * Picking one up, it looks like each card has two lists of numbers separated by
+ * a vertical bar (|): a list of winning numbers and then a list of numbers you
+ * have. You organize the information into a table (your puzzle input).
+ *
+ * As far as the Elf has been able to figure out, you have to figure out which
+ * of the numbers you have appear in the list of winning numbers. The first
+ * match makes the card worth one point and each match after the first doubles
+ * the point value of that card.
+ *
+ * For example:
+ *
+ * Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53
+ * Card 2: 13 32 20 16 61 | 61 30 68 82 17 32 24 19
+ * Card 3:  1 21 53 59 44 | 69 82 63 72 16 21 14  1
+ * Card 4: 41 92 73 84 69 | 59 84 76 51 58  5 54 83
+ * Card 5: 87 83 26 28 32 | 88 30 70 12 93 22 82 36
+ * Card 6: 31 18 13 56 72 | 74 77 10 23 35 67 36 11
+ *
+ * In the above example, card 1 has five winning numbers (41, 48, 83, 86, and
+ * 17) and eight numbers you have (83, 86, 6, 31, 17, 9, 48, and 53). Of the
+ * numbers you have, four of them (48, 83, 17, and 86) are winning numbers! That
+ * means card 1 is worth 8 points (1 for the first match, then doubled three
+ * times for each of the three matches after the first).
+ *
+ *     Card 2 has two winning numbers (32 and 61), so it is worth 2 points.
+ *     Card 3 has two winning numbers (1 and 21), so it is worth 2 points.
+ *     Card 4 has one winning number (84), so it is worth 1 point.
+ *     Card 5 has no winning numbers, so it is worth no points.
+ *     Card 6 has no winning numbers, so it is worth no points.
+ *
+ * So, in this example, the Elf's pile of scratchcards is worth 13 points.
+ *
+ * Take a seat in the large pile of colorful cards. How many points are they
+ * worth in total?
+ */
+
+aoc::Answer part1(const scratchcards &cards) {
+  int total = aoc::parallelReduce(
+      cards.order.size(), CARD_CHUNK, 0,
+      [&](int &points, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          int card = cards.order[i];
+          int matches = countMatches(cards.winning.find(card)->second,
+                                     cards.scratch.find(card)->second);
+          if (matches > 0)
+            points += 1 << (matches - 1);
+        }
+      },
+      [](int &all, int chunk) { all += chunk; });
+
+  return {"Part 1 Total Points is ", total};
+}
+
+scratchcards parse(const aoc::Input &input) {
+  scratchcards cards;
+  aoc::Lines lines = input.lines();
+  parseNumbers(cards.winning, cards.scratch, cards.order, lines);
+  return cards;
+}
+
+/**
+ *                             --- Part Two ---
+ *
+ * Just as you're about to report your findings to the Elf, one of you realizes
+ * that the rules have actually been printed on the back of every card this
+ * whole time.
+ *
+ * There's no such thing as "points". Instead, scratchcards only cause you to
+ * win more scratchcards equal to the number of winning numbers you have.
+ *
+ * Specifically, you win copies of the scratchcards below the winning card equal
+ * to the number of matches. So, if card 10 were to have 5 matching numbers, you
+ * would win one copy each of cards 11, 12, 13, 14, and 15.
+ *
+ * Copies of scratchcards are scored like normal scratchcards and have the same
+ * card number as the card they copied. So, if you win a copy of card 10 and it
+ * has 5 matching numbers, it would then win a copy of the same cards that the
+ * original card 10 won: cards 11, 12, 13, 14, and 15. This process repeats
+ * until none of the copies cause you to win any more cards. (Cards will never
+ * make you copy a card past the end of the table.)
+ *
+ * This time, the above example goes differently:
+ *
+ * Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53
+ *
+ * Card 2: 13 32 20 16 61 | 61 30 68 82 17 32 24 19
+ * Card 3:  1 21 53 59 44 | 69 82 63 72 16 21 14  1
+ * Card 4: 41 92 73 84 69 | 59 84 76 51 58  5 54 83
+ * Card 5: 87 83 26 28 32 | 88 30 70 12 93 22 82 36
+ *
+ * Card 6: 31 18 13 56 72 | 74 77 10 23 35 67 36 11
+ *
+ * Card 1 has four matching numbers, so you win one copy each of the next
+ * four cards: cards 2, 3, 4, and 5. Your original card 2 has two matching
+ * numbers, so you win one copy each of cards 3 and 4. Your copy of card 2 also
+ * wins one copy each of cards 3 and 4. Your four instances of card 3 (one
+ * original and three copies) have two matching numbers, so you win four copies
+ * each of cards 4 and 5. Your eight instances of card 4 (one original and seven
+ * copies) have one matching number, so you win eight copies of card 5. Your
+ * fourteen instances of card 5 (one original and thirteen copies) have no
+ * matching numbers and win no more cards. Your one instance of card 6 (one
+ * original) has no matching numbers and wins no more cards.
+ *
+ * Once all of the originals and copies have been processed, you end up with 1
+ * instance of card 1, 2 instances of card 2, 4 instances of card 3, 8 instances
+ * of card 4, 14 instances of card 5, and 1 instance of card 6. In total, this
+ * example pile of scratchcards causes you to ultimately have 30 scratchcards!
+ *
+ * Process all of the original and copied scratchcards until no more
+ * scratchcards are won. Including the original set of scratchcards, how many
+ * total scratchcards do you end up with?
+ */
+aoc::Answer part2(const scratchcards &cards, std::vector<int> &save) {
+  // copies won by each card, -1 until counted. save comes from the caller's
+  // workspace, so solving again reuses it once it fits the cards.
+  int lastCard = cards.winning.empty() ? 0 : cards.winning.rbegin()->first;
+  save.assign(lastCard + 1, -1);
+
+  int count = 0;
+  for (int i = 1; i <= cards.winning.size(); i++)
+    count += 1 + countCopies(i, cards.winning, cards.scratch, save);
+
+  return {"Part 2 Scratchcard Count is ", count};
+}
+
+int countCopies(int gameNumber, const cardNumbers &winning,
+                const cardNumbers &scratch, std::vector<int> &save) {
+  AOC_DEPTH("countCopies depth");
+  AOC_COUNT("countCopies calls", 1);
+
+  // a card past the last one wins nothing
+  auto winningNumbers = winning.find(gameNumber);
+  auto scratchNumbers = scratch.find(gameNumber);
+  if (winningNumbers == winning.end() || scratchNumbers == scratch.end())
+    return 0;
+
+  int matches = countMatches(winningNumbers->second, scratchNumbers->second);
+  int copyCount = matches;
+
+  for (int i = gameNumber + 1; i <= gameNumber + matches; i++) {
+    AOC_COUNT("memo lookups", 1);
+    if (i >= save.size())
+      continue;
+    if (save[i] < 0)
+      save[i] = countCopies(i, winning, scratch, save);
+    copyCount += save[i];
+  }
+
+  return copyCount;
+}
+
+void parseNumbers(cardNumbers &w, cardNumbers &s, std::pmr::vector<int> &order,
+                  aoc::Lines &lines) {
+  std::string_view line;
+  aoc::Tokens tokens;
+  while (lines.next(line)) {
+    // same arena as the maps, so moving them in doesn't copy
+    std::pmr::set<int> winningNums(aoc::arena());
+    std::pmr::set<int> scratchNums(aoc::arena());
+    int gameNumber = parseCard(line, tokens, winningNums, scratchNums);
+
+    w[gameNumber] = std::move(winningNums);
+    s[gameNumber] = std::move(scratchNums);
+    order.push_back(gameNumber);
+  }
+}
+
+/**
+ * Read one card's numbers, returning its card number
+ */
+int parseCard(std::string_view line, aoc::Tokens &tokens,
+              std::pmr::set<int> &winningNums,
+              std::pmr::set<int> &scratchNums) {
+  // keep empty tokens, the card numbers are padded with extra spaces
+  aoc::tokenize(line, tokens, " ", true);
+
+  bool onWinningNumbers = true;
+  int gameNumber = 0;
+
+  int start = 0;
+  for (int i = 0; i < tokens.size(); i++) {
+    std::string_view token = tokens[i];
+    if (token.find(":") != std::string::npos) {
+      gameNumber = aoc::toInt<int>(token.substr(0, token.size() - 1));
+      start = i + 1;
+      break;
+    }
+  }
+
+  for (int i = start; i < tokens.size(); i++) {
+    std::string_view token = tokens[i];
+    if (token == "" || token == " ")
+      continue;
+    if (token == "|") {
+      onWinningNumbers = false;
+      continue;
+    }
+
+    if (onWinningNumbers) {
+      winningNums.insert(aoc::toInt<int>(token));
+    } else {
+      scratchNums.insert(aoc::toInt<int>(token));
+    }
+  }
+  return gameNumber;
+}
+
+/**
+ * How many of a card's scratched numbers are winning numbers
+ */
+int countMatches(const std::pmr::set<int> &winningNums,
+                 const std::pmr::set<int> &scratchNums) {
+  int matches = 0;
+  for (int scratchOffNumber : scratchNums)
+    matches += winningNums.count(scratchOffNumber);
+  return matches;
+}
+
+/**
+ * Streaming
+ *
+ * A card's copies only come from the few cards before it, so instead of
+ * keeping every card, keep the extra copies already won for the next cards.
+ * That queue is never longer than the most matches a card can have.
+ */
+void stream(aoc::LineStream &lines, std::ostream &out) {
+  std::deque<int> wonCopies;
+  std::pmr::set<int> winningNums;
+  std::pmr::set<int> scratchNums;
+  aoc::Tokens tokens;
+
+  int points = 0;
+  int count = 0;
+  std::string_view line;
+  while (lines.next(line)) {
+    winningNums.clear();
+    scratchNums.clear();
+    parseCard(line, tokens, winningNums, scratchNums);
+
+    int matches = countMatches(winningNums, scratchNums);
+    if (matches > 0)
+      points += 1 << (matches - 1);
+
+    int instances = 1;
+    if (!wonCopies.empty()) {
+      instances += wonCopies.front();
+      wonCopies.pop_front();
+    }
+    count += instances;
+
+    if (wonCopies.size() < matches)
+      wonCopies.resize(matches, 0);
+    for (int i = 0; i < matches; i++)
+      wonCopies[i] += instances;
+  }
+
+  out << aoc::Answer("Part 1 Total Points is ", points);
+  out << aoc::Answer("Part 2 Scratchcard Count is ", count);
+}
+
+} // namespace day04
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day 4: Scratchcards
+ */
+namespace day04 {
+  const aoc::Solver &solver();
+} // namespace day04
@@ -0,0 +1,552 @@
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../common/arena.h"
+#include "../common/input.h"
+#include "../common/instrument.h"
+#include "../common/model_cache.h"
+#include "../common/parse_int.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "../common/tokenize.h"
+#include "day.h"
+
+namespace day05 {
+
+/**
+ * Declarations
+ */
+const long NOT_VALID = -1;
+struct range;
+struct mapping;
+struct piece;
+struct almanac;
+struct composition;
+
+// the almanac and everything parse builds on the way live in the run's arena
+using mappings = std::pmr::vector<mapping>;
+// maps composed while solving, see composition
+using pieces = std::vector<piece>;
+
+almanac parse(const aoc::Input&);
+void parseFile(aoc::Lines&, almanac&);
+void parseMapping(mappings&, const aoc::Tokens&);
+void save(const almanac& puzzle, aoc::ModelWriter& out);
+almanac load(aoc::ModelReader& in);
+const pieces& seedsToLocations(const almanac& puzzle, composition& composed);
+
+aoc::Answer part1(const almanac& puzzle, composition& composed);
+aoc::Answer part1Reference(const almanac& puzzle);
+
+aoc::Answer part2(const almanac& puzzle, composition& composed);
+aoc::Answer part2Reference(const almanac& puzzle);
+
+/**
+ * structs 
+ */
+
+/**
+ * Represents a range [start, end]
+ */
+struct range {
+    long start;
+    long end;
+    range(long s, long e) : start(s), end(e) {}
+    range() : start(NOT_VALID), end(NOT_VALID) {}
+
+    bool isValid() const { return start != NOT_VALID && end != NOT_VALID; }
+
+    bool inRange(long target) const { return target >= start && target <= end; }
+
+    bool hasOverlap(range other) const {
+        return (start <= other.end) && (end >= other.start);
+    }
+    /*
+     * Offset from start to target
+     *  Assume we know target is in range
+     */
+    long offset(long target) const { return target - start; }
+};
+
+/**
+ * Represents a mapping
+ */
+struct mapping {
+    range from;
+    range to;
+    mapping(range f, range t) : from(f), to(t) {}
+
+    bool has(long target) const { return from.inRange(target); }
+    /*
+     * Assumes target already checked if it's in the mapping
+     */
+    long find(long target) const { return to.start + from.offset(target); }
+
+
+    /**
+     * Get Overlap
+     * Assumes their is overlap
+     * Will return extra if not mapped
+     */
+    std::tuple<mapping, range, range> overlap(range target) const {
+        if (target.start < from.start) {
+            long offset = std::abs(target.end - from.start);
+
+            long fromEnd = target.end;
+
+            mapping result({from.start, fromEnd},
+                           {to.start, to.start + offset});
+
+            range extra(target.start, from.start - 1);
+            range extra2(-1, -1);  // no extra
+
+            if (target.end > from.end) {
+                extra2.start = from.end + 1;
+                extra2.end = target.end;
+
+                fromEnd = from.end;
+                offset = 0;
+
+                result.from = {from.start, fromEnd};
+                result.to = {to.start, to.end + offset};
+            }
+
+            return std::make_tuple(result, extra, extra2);
+
+        } else if (target.end > from.end) {
+            long offset = std::abs(from.end - target.start);
+            mapping result({target.start, from.end}, {to.end - offset, to.end});
+
+            range extra(from.end + 1, target.end);
+            range extra2(-1, -1);  // no extra
+
+            return std::make_tuple(result, extra, extra2);
+
+        } else if (target.start == from.start && target.end == from.end) {
+            mapping result({from.start, from.end}, {to.start, to.end});
+            range extra(-1, -1);   // no extra
+            range extra2(-1, -1);  // no extra
+
+
+            return std::make_tuple(result, extra, extra2);
+        } else {
+            long offsetStart = std::abs(target.start - from.start);
+            long offsetEnd = std::abs(target.start - from.start)
+                           + std::abs(target.end - target.start);
+
+            mapping result({target.start, target.end},
+                           {to.start + offsetStart, to.start + offsetEnd});
+
+            range extra(-1, -1);   // no extra
+            range extra2(-1, -1);  // no extra
+
+            return std::make_tuple(result, extra, extra2);
+        }
+    }
+};
+
+/**
+ * Numbers in [start, end] move by shift, see Composed maps below
+ */
+struct piece {
+    long start;
+    long end;
+    long shift;
+};
+
+/**
+ * Represents the whole almanac
+ */
+struct almanac {
+    std::pmr::vector<long> seedsPart1 {aoc::arena()};
+    std::pmr::vector<range> seedsPart2 {aoc::arena()};
+    mappings seedToSoil {aoc::arena()};
+    mappings soilToFertilizer {aoc::arena()};
+    mappings fertilizerToWater {aoc::arena()};
+    mappings waterToLight {aoc::arena()};
+    mappings lightToTemperature {aoc::arena()};
+    mappings temperatureToHumidity {aoc::arena()};
+    mappings humidityToLocation {aoc::arena()};
+
+    /**
+     * Part 1 helper method
+     * Just checks if target is part of list of mapping. Return itself if not
+     * found in any map.
+     */
+    long findInMap(long target, mappings maps) const {
+        for (int i = 0; i < maps.size(); i++) {
+            mapping map = maps[i];
+            if (map.has(target)) { return map.find(target); }
+        }
+
+        return target;
+    }
+
+    long findLowestLocationPart1() const {
+        long lowest = LONG_MAX;
+
+        std::vector<mappings> allMaps;
+        allMaps.push_back(seedToSoil);
+        allMaps.push_back(soilToFertilizer);
+        allMaps.push_back(fertilizerToWater);
+        allMaps.push_back(waterToLight);
+        allMaps.push_back(lightToTemperature);
+        allMaps.push_back(temperatureToHumidity);
+        allMaps.push_back(humidityToLocation);
+
+        for (auto& seed : seedsPart1) {
+            long target = seed;
+            for (auto& map : allMaps) { target = findInMap(target, map); }
+
+            if (target < lowest) lowest = target;
+        }
+
+        return lowest;
+    }
+    std::vector<range> getDstFromRanges(std::vector<range> targets,
+                                        mappings maps) const {
+        AOC_TIMER("getDstFromRanges");
+        std::vector<range> dst;
+
+        while (!targets.empty()) {
+            // get any target to check
+            range target = targets.back();
+            targets.pop_back();  // dont forget to delete it
+
+            bool found = false;
+            for (auto& map : maps) {
+                AOC_COUNT("ranges checked", 1);
+                if (target.hasOverlap(map.from)) {
+                    found = true;
+
+                    auto overlap = map.overlap(target);
+
+                    dst.push_back(std::get<0>(overlap).to);
+
+                    if (std::get<1>(overlap).isValid()) {
+                        targets.emplace_back(std::get<1>(overlap));
+                        if (std::get<2>(overlap).isValid())
+                            targets.emplace_back(std::get<2>(overlap));
+                    }
+                    break;
+                }
+            }
+
+            // looked through every map and nothing so it falls through
+            if (!found) { dst.push_back(target); }
+        }
+
+        return dst;
+    }
+
+    long findLowestLocationPart2() const {
+        std::vector<mappings> allMaps;
+        allMaps.push_back(seedToSoil);
+        allMaps.push_back(soilToFertilizer);
+        allMaps.push_back(fertilizerToWater);
+        allMaps.push_back(waterToLight);
+        allMaps.push_back(lightToTemperature);
+        allMaps.push_back(temperatureToHumidity);
+        allMaps.push_back(humidityToLocation);
+
+        // initial target range
+        std::vector<range> destinations(seedsPart2.begin(), seedsPart2.end());
+
+        for (int i = 0; i < allMaps.size(); i++)
+            destinations = getDstFromRanges(destinations, allMaps[i]);
+
+        /**
+         * last destinations should be the locations, so
+         * look through them and get the smallest one
+         */
+        long lowest = LONG_MAX;
+        for (int i = 0; i < destinations.size(); i++) {
+            if (destinations[i].start < lowest) lowest = destinations[i].start;
+        }
+        return lowest;
+    }
+};
+
+/**
+ * parsing
+ */
+
+/**
+ * enums to help with parsing
+ */
+enum parseState {
+    SEEDS,
+    SEED_TO_SOIL,
+    SOIL_TO_FERTILIZER,
+    FERTILIZER_TO_WATER,
+    WATER_TO_LIGHT,
+    LIGHT_TO_TEMPERATURE,
+    TEMPERATURE_TO_HUMIDITY,
+    HUMIDITY_TO_LOCATION
+};
+void parseMapping(mappings& map, const aoc::Tokens& tokens) {
+    long from = aoc::toInt<long>(tokens[1]);
+    long to = aoc::toInt<long>(tokens[0]);
+    long length = aoc::toInt<long>(tokens[2]);
+
+    range fromRange(from, from + length - 1);
+    range toRange(to, to + length - 1);
+
+    mapping mapped(fromRange, toRange);
+
+    map.push_back(mapped);
+}
+void parseFile(aoc::Lines& lines, almanac& puzzle) {
+    std::string_view line;
+    aoc::Tokens tokens;
+    parseState state = SEEDS;
+    while (lines.next(line)) {
+        if (line.empty()) continue;
+        if (line.find("seed-to-soil") != std::string::npos) {
+            state = SEED_TO_SOIL;
+            continue;
+        } else if (line.find("soil-to-fertilizer") != std::string::npos) {
+            state = SOIL_TO_FERTILIZER;
+            continue;
+        } else if (line.find("fertilizer-to-water") != std::string::npos) {
+            state = FERTILIZER_TO_WATER;
+            continue;
+        } else if (line.find("water-to-light") != std::string::npos) {
+            state = WATER_TO_LIGHT;
+            continue;
+        } else if (line.find("light-to-temperature") != std::string::npos) {
+            state = LIGHT_TO_TEMPERATURE;
+            continue;
+        } else if (line.find("temperature-to-humidity") != std::string::npos) {
+            state = TEMPERATURE_TO_HUMIDITY;
+            continue;
+        } else if (line.find("humidity-to-location") != std::string::npos) {
+            state = HUMIDITY_TO_LOCATION;
+            continue;
+        }
+
+        aoc::tokenize(line, tokens, " ", true);
+
+        switch (state) {
+            case SEEDS: {
+                // part 1 reads the seeds as numbers, part 2 as ranges
+                for (int i = 1; i < tokens.size(); i++)
+                    puzzle.seedsPart1.push_back(aoc::toInt<long>(tokens[i]));
+                for (int i = 1; i < tokens.size(); i += 2) {
+                    long from = aoc::toInt<long>(tokens[i]);
+                    long length = aoc::toInt<long>(tokens[i + 1]);
+                    range seedRange(from, from + length - 1);
+                    puzzle.seedsPart2.push_back(seedRange);
+                }
+                break;
+            }
+            case SEED_TO_SOIL: {
+                parseMapping(puzzle.seedToSoil, tokens);
+                break;
+            }
+            case SOIL_TO_FERTILIZER: {
+                parseMapping(puzzle.soilToFertilizer, tokens);
+                break;
+            }
+            case FERTILIZER_TO_WATER: {
+                parseMapping(puzzle.fertilizerToWater, tokens);
+                break;
+            }
+            case WATER_TO_LIGHT: {
+                parseMapping(puzzle.waterToLight, tokens);
+                break;
+            }
+            case LIGHT_TO_TEMPERATURE: {
+                parseMapping(puzzle.lightToTemperature, tokens);
+                break;
+            }
+            case TEMPERATURE_TO_HUMIDITY: {
+                parseMapping(puzzle.temperatureToHumidity, tokens);
+                break;
+            }
+            case HUMIDITY_TO_LOCATION: {
+                parseMapping(puzzle.humidityToLocation, tokens);
+                break;
+            }
+        }
+    }
+}
+
+almanac parse(const aoc::Input& input) {
+    aoc::Lines lines = input.lines();
+    almanac puzzle;
+    parseFile(lines, puzzle);
+    return puzzle;
+}
+
+/**
+ * Model cache, every list of the almanac in order
+ */
+mappings almanac::* const MAPS[] = {
+    &almanac::seedToSoil,         &almanac::soilToFertilizer,
+    &almanac::fertilizerToWater,  &almanac::waterToLight,
+    &almanac::lightToTemperature, &almanac::temperatureToHumidity,
+    &almanac::humidityToLocation,
+};
+
+void save(const almanac& puzzle, aoc::ModelWriter& out) {
+    out.putArray(puzzle.seedsPart1);
+    out.putArray(puzzle.seedsPart2);
+    for (auto maps : MAPS) out.putArray(puzzle.*maps);
+}
+
+almanac load(aoc::ModelReader& in) {
+    almanac puzzle;
+    in.getArray(puzzle.seedsPart1);
+    in.getArray(puzzle.seedsPart2);
+    for (auto maps : MAPS) in.getArray(puzzle.*maps);
+    return puzzle;
+}
+
+/**
+ * Composed maps
+ *
+ * Every map moves each stretch of numbers by a fixed amount, so it can be
+ * written as a sorted list of pieces covering [0, LONG_MAX], unmapped
+ * stretches moving by 0. Two such lists compose into one: each piece of
+ * the first is cut wherever its image crosses into another piece of the
+ * second. Composing all seven gives seeds straight to locations, so a seed
+ * is one binary search and a seed range is just the pieces it overlaps.
+ * This assumes no two sources in one map overlap, as the puzzle promises.
+ */
+
+/**
+ * The lists a composition is built in. It's scratch from the caller's
+ * workspace, so composing again reuses them; cover ends up holding all
+ * seven maps composed.
+ */
+struct composition {
+    pieces cover;
+    pieces composed;
+    pieces map;
+    pieces mapped;
+};
+
+bool startsBefore(const piece& first, const piece& second) {
+    return first.start < second.start;
+}
+
+/**
+ * The piece of cover holding target; cover starts at 0
+ */
+pieces::const_iterator findPiece(const pieces& cover, long target) {
+    return std::upper_bound(cover.begin(), cover.end(), target,
+                            [](long value, const piece& p) {
+                                return value < p.start;
+                            }) -
+           1;
+}
+
+/**
+ * Write maps into cover as pieces, sorting them in mapped on the way
+ */
+void coverOf(const mappings& maps, pieces& mapped, pieces& cover) {
+    mapped.clear();
+    for (const mapping& map : maps) {
+        if (map.from.end < map.from.start) continue;  // zero length
+        mapped.push_back(
+            {map.from.start, map.from.end, map.to.start - map.from.start});
+    }
+    std::sort(mapped.begin(), mapped.end(), startsBefore);
+
+    cover.clear();
+    long next = 0;
+    for (const piece& p : mapped) {
+        if (p.start > next) cover.push_back({next, p.start - 1, 0});
+        cover.push_back(p);
+        next = p.end + 1;
+    }
+    cover.push_back({next, LONG_MAX, 0});
+}
+
+void compose(const pieces& first, const pieces& second, pieces& cover) {
+    cover.clear();
+    for (const piece& p : first) {
+        long at = p.start + p.shift;
+        long last = p.end + p.shift;
+        for (auto into = findPiece(second, at); at <= last; ++into) {
+            long end = std::min(last, into->end);
+            cover.push_back(
+                {at - p.shift, end - p.shift, p.shift + into->shift});
+            if (end == LONG_MAX) break;
+            at = end + 1;
+        }
+    }
+}
+
+const pieces& seedsToLocations(const almanac& puzzle, composition& composed) {
+    coverOf(puzzle.*MAPS[0], composed.mapped, composed.cover);
+    for (size_t i = 1; i < std::size(MAPS); i++) {
+        coverOf(puzzle.*MAPS[i], composed.mapped, composed.map);
+        compose(composed.cover, composed.map, composed.composed);
+        std::swap(composed.cover, composed.composed);
+    }
+    return composed.cover;
+}
+
+/**
+ * Part 1
+ */
+aoc::Answer part1(const almanac& puzzle, composition& composed) {
+    const pieces& cover = seedsToLocations(puzzle, composed);
+    long lowest = LONG_MAX;
+    for (long seed : puzzle.seedsPart1)
+        lowest = std::min(lowest, seed + findPiece(cover, seed)->shift);
+    return {"Part 1 Lowest Location is ", lowest};
+}
+
+aoc::Answer part1Reference(const almanac& puzzle) {
+    long lowest = puzzle.findLowestLocationPart1();
+    return {"Part 1 Lowest Location is ", lowest};
+}
+
+/**
+ * Part 2
+ */
+
+aoc::Answer part2(const almanac& puzzle, composition& composed) {
+    const pieces& cover = seedsToLocations(puzzle, composed);
+    long lowest = LONG_MAX;
+    for (const range& seeds : puzzle.seedsPart2) {
+        // each piece is lowest at its first seed
+        for (auto p = findPiece(cover, seeds.start);
+             p != cover.end() && p->start <= seeds.end; ++p)
+            lowest = std::min(lowest, std::max(p->start, seeds.start) +
+                                          p->shift);
+    }
+    return {"Part 2 Lowest Location is ", lowest};
+}
+
+aoc::Answer part2Reference(const almanac& puzzle) {
+    long lowest = puzzle.findLowestLocationPart2();
+    return {"Part 2 Lowest Location is ", lowest};
+}
+
+/**
+ * Main Method
+ */
+const auto daySolver = aoc::makeSolver(
+    aoc::cached("day05/1", parse, save, load), part1, part2);
+// pushing ranges through the maps one at a time, for fuzz/ to check against
+const auto referenceSolver =
+    aoc::makeSolver(parse, part1Reference, part2Reference);
+
+const aoc::Solver& solver() { return daySolver; }
+const aoc::Solver& reference() { return referenceSolver; }
+
+}  // namespace day05
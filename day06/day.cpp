@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input.h"
+#include "../common/parse_int.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "../common/tokenize.h"
+#include "day.h"
+
+namespace day06 {
+
+struct race {
+  ulong time;
+  ulong distance;
+};
+
+/**
+ * Part 1 reads every column as its own race, part 2 joins the digits on each
+ * line into one long race
+ */
+struct raceSheet {
+  std::vector<race> races;
+  race combined;
+};
+
+/**
+ * declarations
+ */
+raceSheet parse(const aoc::Input &input);
+void parseLine(std::string_view line, bool parsingTime, raceSheet &sheet,
+               aoc::Tokens &tokens);
+
+aoc::Answer part1(const raceSheet &sheet);
+aoc::Answer part1Reference(const raceSheet &sheet);
+
+aoc::Answer part2(const raceSheet &sheet);
+aoc::Answer part2Reference(const raceSheet &sheet);
+
+/**
+ * Count the number of ways to win a race
+ *
+ * Holding for t goes t * (time - t), a parabola that peaks halfway, so the
+ * winning holds are the run between the two places it crosses the record.
+ * A floating point estimate of the lower crossing is nudged onto the exact
+ * one with integer checks, in 128 bits since time squared can overflow 64.
+ */
+ulong waysToWin(race race) {
+  ulong totalTime = race.time;
+  ulong distanceToBeat = race.distance;
+  auto beats = [=](ulong timeCharged) {
+    return static_cast<unsigned __int128>(timeCharged) *
+               (totalTime - timeCharged) >
+           distanceToBeat;
+  };
+  if (!beats(totalTime / 2))
+    return 0;
+
+  double discriminant =
+      static_cast<double>(totalTime) * totalTime - 4.0 * distanceToBeat;
+  double estimate = (totalTime - std::sqrt(std::max(discriminant, 0.0))) / 2;
+  ulong lowest = std::min<ulong>(std::max(estimate, 0.0), totalTime / 2);
+  while (lowest > 0 && beats(lowest - 1))
+    lowest--;
+  while (!beats(lowest))
+    lowest++;
+
+  // the winning holds are symmetric about the peak
+  return totalTime - 2 * lowest + 1;
+}
+
+/**
+ * Count the number of ways to win a race by trying every charge time, kept
+ * to check waysToWin() against
+ */
+ulong waysToWinByTrial(race race) {
+  ulong totalTime = race.time;
+  ulong distanceToBeat = race.distance;
+  ulong countWins = 0;
+
+  for (ulong timeCharged = 1; timeCharged < totalTime; timeCharged++) {
+    ulong timeLeft = totalTime - timeCharged;
+    ulong speed = timeCharged;
+    ulong distance = speed * timeLeft;
+    if (distance > distanceToBeat)
+      countWins++;
+  }
+  return countWins;
+}
+
+/**
+ * Parsing
+ */
+raceSheet parse(const aoc::Input &input) {
+  aoc::Lines lines = input.lines();
+
+  raceSheet sheet{};
+  std::string_view line;
+  aoc::Tokens tokens;
+  bool parsingTime = true;
+  while (lines.next(line)) {
+    parseLine(line, parsingTime, sheet, tokens);
+    parsingTime = false;
+  }
+
+  return sheet;
+}
+
+/**
+ * Read the Time or the Distance line into the sheet
+ */
+void parseLine(std::string_view line, bool parsingTime, raceSheet &sheet,
+               aoc::Tokens &tokens) {
+  aoc::tokenize(line, tokens);
+
+  // fill races if empty
+  if (sheet.races.empty() && tokens.size() > 1)
+    sheet.races.resize(tokens.size() - 1);
+
+  std::string number;
+  for (int i = 1; i < tokens.size(); i++) {
+    ulong value = aoc::toInt<ulong>(tokens[i]);
+    if (parsingTime)
+      sheet.races[i - 1].time = value;
+    else
+      sheet.races[i - 1].distance = value;
+
+    number.append(tokens[i]);
+  }
+
+  if (parsingTime)
+    sheet.combined.time = aoc::toInt<ulong>(number);
+  else
+    sheet.combined.distance = aoc::toInt<ulong>(number);
+}
+
+/**
+ * Part 1
+ */
+aoc::Answer part1Using(const raceSheet &sheet, ulong (*ways)(race)) {
+  ulong result = 1;
+  for (int i = 0; i < sheet.races.size(); i++)
+    result *= ways(sheet.races[i]);
+
+  return {"Part 1: Number of ways to win for each race multiplied is ",
+          result};
+}
+
+aoc::Answer part1(const raceSheet &sheet) {
+  return part1Using(sheet, waysToWin);
+}
+
+aoc::Answer part1Reference(const raceSheet &sheet) {
+  return part1Using(sheet, waysToWinByTrial);
+}
+
+/**
+ * Part 2
+ */
+aoc::Answer part2Using(const raceSheet &sheet, ulong (*ways)(race)) {
+  ulong result = ways(sheet.combined);
+  return {"Part 2: Number of ways to win for each race multiplied is ",
+          result};
+}
+
+aoc::Answer part2(const raceSheet &sheet) {
+  return part2Using(sheet, waysToWin);
+}
+
+aoc::Answer part2Reference(const raceSheet &sheet) {
+  return part2Using(sheet, waysToWinByTrial);
+}
+
+/**
+ * Streaming
+ *
+ * The whole sheet is two lines, so read them as they come and solve
+ */
+void stream(aoc::LineStream &lines, std::ostream &out) {
+  raceSheet sheet{};
+  std::string_view line;
+  aoc::Tokens tokens;
+  bool parsingTime = true;
+  while (lines.next(line)) {
+    parseLine(line, parsingTime, sheet, tokens);
+    parsingTime = false;
+  }
+
+  out << part1(sheet) << part2(sheet);
+}
+
+/**
+ * main function
+ */
+const auto daySolver = aoc::makeSolver(parse, part1, part2, stream);
+// the solver that tries every charge time, for fuzz/ to check against
+const auto referenceSolver =
+    aoc::makeSolver(parse, part1Reference, part2Reference);
+
+const aoc::Solver &solver() { return daySolver; }
+const aoc::Solver &reference() { return referenceSolver; }
+
+} // namespace day06
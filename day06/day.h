@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day 6: Wait For It
+ */
+namespace day06 {
+  const aoc::Solver &solver();
+
+  /**
+   * The solver the fast path replaced, for fuzz/ to check against
+   */
+  const aoc::Solver &reference();
+} // namespace day06
@@ -0,0 +1,629 @@
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/arena.h"
+#include "../common/input.h"
+#include "../common/model_cache.h"
+#include "../common/parse_int.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "../common/tokenize.h"
+#include "day.h"
+
+namespace day07 {
+
+/**
+ * Camel Cards Game
+ */
+
+enum CamelSuits : int {
+    TWO = 2,
+    THREE,
+    FOUR,
+    FIVE,
+    SIX,
+    SEVEN,
+    EIGHT,
+    NINE,
+    TEN,
+    JOKER,
+    QUEEN,
+    KING,
+    ACE
+};
+
+struct camelGame;
+
+struct Hand {
+    int hand[5];
+    int bid;
+
+    ~Hand() = default;
+};
+
+/**
+ * Five of a kind
+ * Four of a kind
+ * Full house
+ * Three of a kind
+ * Two pair
+ * One pair
+ * High card
+ */
+std::array<int, 20> countSuits(const Hand hand) {
+    std::array<int, 20> count {};
+
+    count[hand.hand[0]] += 1;
+    count[hand.hand[1]] += 1;
+    count[hand.hand[2]] += 1;
+    count[hand.hand[3]] += 1;
+    count[hand.hand[4]] += 1;
+
+    return count;
+}
+
+bool isFiveOfKind(const Hand hand, bool isPart1) {
+    std::array<int, 20> count = countSuits(hand);
+    int pairCount = 0;
+    bool hasThree = false;
+    bool hasFour = false;
+    bool hasFive = false;
+
+    for (int i = CamelSuits::TWO; i <= CamelSuits::ACE; i++) {
+        if (count[i] == 2) pairCount++;
+        if (count[i] == 3) hasThree = true;
+        if (count[i] == 4) hasFour = true;
+        if (count[i] == 5) hasFive = true;
+    }
+    if (!isPart1) {
+        int jokerCount = count[JOKER];
+        if (jokerCount == 1) {
+            if (hasFour) return true;
+            return false;
+        } else if (jokerCount == 2) {
+            if (hasThree) return true;
+            return false;
+        } else if (jokerCount == 3) {
+            if (pairCount == 1) return true;
+            return false;
+        } else if (jokerCount >= 4)
+            return true;
+    }
+    return hasFive;
+}
+bool isFourOfKind(const Hand hand, bool isPart1) {
+    std::array<int, 20> count = countSuits(hand);
+
+    int pairCount = 0;
+    bool hasThree = false;
+    bool hasFour = false;
+
+    for (int i = CamelSuits::TWO; i <= CamelSuits::ACE; i++) {
+        if (count[i] == 2) pairCount++;
+        if (count[i] == 3) hasThree = true;
+        if (count[i] == 4) hasFour = true;
+    }
+
+    if (!isPart1) {
+        int jokerCount = count[JOKER];
+
+        // J4A43
+        if (jokerCount == 1) {
+            if (hasThree) return true;
+            return false;
+        } else if (jokerCount == 2) {
+            // JJ335
+            if (pairCount == 2) return true;
+            return false;
+        } else if (jokerCount == 3) {
+            // JJJ23
+            if (pairCount == 0) return true;
+            else
+                return false;
+        }
+
+        if (jokerCount >= 4) return false;
+    }
+
+    return hasFour;
+}
+
+bool isFullHouse(const Hand hand, bool isPart1) {
+    std::array<int, 20> count = countSuits(hand);
+    int pairCount = 0;
+    bool hasThree = false;
+    bool hasFour = false;
+    for (int i = CamelSuits::TWO; i <= CamelSuits::ACE; i++) {
+        if (count[i] == 2) pairCount++;
+        if (count[i] == 3) hasThree = true;
+        if (count[i] == 4) hasFour = true;
+    }
+
+    if (!isPart1) {
+        int jokerCount = count[JOKER];
+
+        // J2734
+        if (jokerCount == 1) {
+            if (pairCount == 2) return true;
+            return false;
+        }
+        if (jokerCount >= 2) return false;
+    }
+    return (pairCount == 1) && hasThree;
+}
+
+bool isThreeOfKind(const Hand hand, bool isPart1) {
+    std::array<int, 20> count = countSuits(hand);
+    bool hasThree = false;
+    int pairCount = 0;
+
+    for (int i = CamelSuits::TWO; i <= CamelSuits::ACE; i++) {
+        if (count[i] == 2) pairCount++;
+        if (count[i] == 3) hasThree = true;
+    }
+
+
+    if (!isPart1) {
+        // JJ835
+        int jokerCount = count[JOKER];
+
+        if (jokerCount == 1) {
+            if ((pairCount == 1) && !hasThree) return true;
+            return false;
+        } else if (jokerCount == 2) {
+            if ((pairCount == 1) && !hasThree) return true;
+            else
+                return false;
+        } else if (jokerCount > 0)
+            return false;
+    }
+
+    return hasThree && !(pairCount > 0);
+}
+bool isTwoPair(const Hand hand, bool isPart1) {
+    std::array<int, 20> count = countSuits(hand);
+    int pairCount = 0;
+    bool hasThree = false;
+
+    for (int i = CamelSuits::TWO; i <= CamelSuits::ACE; i++) {
+        if (count[i] == 2) pairCount++;
+        if (count[i] == 3) hasThree = true;
+    }
+
+    if (!isPart1) {
+        int jokerCount = count[JOKER];
+
+        if (jokerCount >= 1) return false;
+    }
+
+
+    return pairCount == 2;
+}
+bool isOnePair(const Hand hand, bool isPart1) {
+    std::array<int, 20> count = countSuits(hand);
+    int pairCount = 0;
+    bool hasThree = false;
+    // for part 2
+    bool hasFour = false;
+    bool hasFive = false;
+
+
+    for (int i = CamelSuits::TWO; i <= CamelSuits::ACE; i++) {
+        if (count[i] == 2) pairCount++;
+        if (count[i] == 3) hasThree = true;
+        if (count[i] == 4) hasFour = true;
+        if (count[i] == 5) hasFive = true;
+    }
+
+    if (!isPart1) {
+        int jokerCount = count[JOKER];
+
+        if (jokerCount == 1) {
+            if (hasFour || hasThree || hasFive || (pairCount >= 1))
+                return false;
+            return true;
+        } else if (jokerCount > 0)
+            return false;
+    }
+
+    return (pairCount == 1) && !hasThree;
+}
+bool isHighCard(const Hand hand, bool isPart1) {
+    std::array<int, 20> count = countSuits(hand);
+
+    if (!isPart1) {
+        // Just having joker guarantees a pair
+        if (count[JOKER] >= 1) return false;
+    }
+
+    for (int i = CamelSuits::TWO; i <= CamelSuits::ACE; i++) {
+        if (count[i] > 1) return false;
+    }
+
+    return true;
+}
+
+int getHandStrength(const Hand hand, bool isPart1) {
+    if (isFiveOfKind(hand, isPart1)) return 7;
+    if (isFourOfKind(hand, isPart1)) return 6;
+    if (isFullHouse(hand, isPart1)) return 5;
+    if (isThreeOfKind(hand, isPart1)) return 4;
+    if (isTwoPair(hand, isPart1)) return 3;
+    if (isOnePair(hand, isPart1)) return 2;
+
+    return 1;
+}
+
+bool isEqual(const Hand a, const Hand b, bool isPart1) {
+    return getHandStrength(a, isPart1) == getHandStrength(b, isPart1);
+}
+
+bool isStronger(const Hand a, const Hand b, bool isPart1) {
+    if (isEqual(a, b, isPart1)) {
+        for (int i = 0; i < 5; i++) {
+            int suitA = a.hand[i];
+            int suitB = b.hand[i];
+
+            if (!isPart1) {
+                if (suitA == JOKER) suitA = 0;
+                if (suitB == JOKER) suitB = 0;
+            }
+
+            if (suitA > suitB) return true;
+            else if (suitA < suitB)
+                return false;
+        }
+        return false;
+    }
+
+    return getHandStrength(a, isPart1) > getHandStrength(b, isPart1);
+}
+
+int charToSuit(char ch) {
+    if (ch >= '2' && ch <= '9') return CamelSuits::TWO + (ch - '2');
+    if (ch == 'T') return CamelSuits::TEN;
+    if (ch == 'J') return CamelSuits::JOKER;
+    if (ch == 'Q') return CamelSuits::QUEEN;
+    if (ch == 'K') return CamelSuits::KING;
+    if (ch == 'A') return CamelSuits::ACE;
+    return 0;
+}
+
+/**
+ * Fill in hand's cards from str, skipping anything that isn't a card. A
+ * hand with fewer than five cards keeps 0 for the rest.
+ */
+void stringToHand(std::string_view str, Hand& hand) {
+    int cards = 0;
+    for (char ch : str) {
+        int suit = charToSuit(ch);
+        if (suit != 0 && cards < 5) hand.hand[cards++] = suit;
+    }
+}
+struct camelGame {
+    // from the run's arena, like every other parsed model
+    std::pmr::vector<Hand> hands {aoc::arena()};
+};
+
+/**
+ * The hands being ranked and the space their merges are written to. It's
+ * scratch from the caller's workspace, so ranking again reuses it.
+ */
+struct ranking {
+    std::vector<Hand> hands;
+    std::vector<Hand> merged;
+
+    /**
+     * Sort the game's hands by strength, with jokers wild for part 2
+     */
+    void sortHands(const camelGame& game, bool isPart1) {
+        hands.assign(game.hands.begin(), game.hands.end());
+        merged.resize(hands.size());
+        mergeSort(0, hands.size(), isPart1);
+    }
+
+    /**
+     * Sorting helpers
+     */
+
+    /**
+     * Merge the sorted runs [from, mid) and [mid, to) of hands, the left
+     * run first between equal hands
+     */
+    void merge(size_t from, size_t mid, size_t to, bool isPart1) {
+        size_t indexLeft = from;
+        size_t indexRight = mid;
+        for (size_t i = from; i < to; i++) {
+            // not the bool for descending order
+            if (indexRight >= to ||
+                (indexLeft < mid &&
+                 !isStronger(hands[indexLeft], hands[indexRight], isPart1)))
+                merged[i] = hands[indexLeft++];
+            else
+                merged[i] = hands[indexRight++];
+        }
+        std::copy(merged.begin() + from, merged.begin() + to,
+                  hands.begin() + from);
+    }
+
+    void mergeSort(size_t from, size_t to, bool isPart1) {
+        if (to - from <= 1) return;
+
+        size_t mid = from + (to - from) / 2;
+        mergeSort(from, mid, isPart1);
+        mergeSort(mid, to, isPart1);
+        merge(from, mid, to, isPart1);
+    }
+};
+
+std::string handToString(Hand hand) {
+    std::string handStr;
+    for (int i = 0; i < 5; i++) {
+        if (hand.hand[i] == 2) handStr.push_back('2');
+        else if (hand.hand[i] == 3)
+            handStr.push_back('3');
+        else if (hand.hand[i] == 4)
+            handStr.push_back('4');
+        else if (hand.hand[i] == 5)
+            handStr.push_back('5');
+        else if (hand.hand[i] == 6)
+            handStr.push_back('6');
+        else if (hand.hand[i] == 7)
+            handStr.push_back('7');
+        else if (hand.hand[i] == 8)
+            handStr.push_back('8');
+        else if (hand.hand[i] == 9)
+            handStr.push_back('9');
+        else if (hand.hand[i] == 10)
+            handStr.push_back('T');
+        else if (hand.hand[i] == 11)
+            handStr.push_back('J');
+        else if (hand.hand[i] == 12)
+            handStr.push_back('Q');
+        else if (hand.hand[i] == 13)
+            handStr.push_back('K');
+        else
+            handStr.push_back('A');
+    }
+
+    return handStr;
+}
+
+/**
+ * Part 1
+ */
+void printHands(const camelGame& game) {
+    for (const auto& hand : game.hands)
+        std::cout << "Hand: " << handToString(hand) << " Bid: " << hand.bid
+                  << "\n";
+}
+
+/**
+ * Parsing
+ *
+ * Works from either the mapped input's Lines or a LineStream
+ */
+template <typename LineSource>
+camelGame parseLines(LineSource& lines) {
+    camelGame game;
+
+    std::string_view line;
+    aoc::Tokens tokens;
+    while (lines.next(line)) {
+        aoc::tokenize(line, tokens);
+        Hand hand {};
+        stringToHand(tokens[0], hand);
+        hand.bid = aoc::toInt<int>(tokens[1]);
+        game.hands.push_back(hand);
+    }
+
+    return game;
+}
+
+camelGame parse(const aoc::Input& input) {
+    aoc::Lines lines = input.lines();
+    return parseLines(lines);
+}
+
+/**
+ * Model cache, the encoded hands as they are in memory
+ */
+void save(const camelGame& game, aoc::ModelWriter& out) {
+    out.putArray(game.hands);
+}
+
+camelGame load(aoc::ModelReader& in) {
+    camelGame game;
+    in.getArray(game.hands);
+    return game;
+}
+
+aoc::Answer part1(const camelGame& game, ranking& ranked) {
+    ranked.sortHands(game, true);
+
+    int rank = 1;
+    int result = 0;
+    for (auto& hand : ranked.hands) {
+        result += hand.bid * rank;
+        rank++;
+    }
+
+    return {"Part 1: Added result is ", result};
+}
+
+/**
+ * Part 2
+ */
+aoc::Answer part2(const camelGame& game, ranking& ranked) {
+    ranked.sortHands(game, false);
+
+    int rank = 1;
+    int result = 0;
+    for (auto& hand : ranked.hands) {
+        result += hand.bid * rank;
+        rank++;
+    }
+
+    return {"Part 2: Added result is ", result};
+}
+
+/**
+ * Streaming
+ *
+ * Ranking needs every hand, so only parsing happens as the input is read;
+ * the hands themselves are still kept for the sort
+ */
+void stream(aoc::LineStream& lines, std::ostream& out) {
+    const camelGame game = parseLines(lines);
+    ranking ranked;
+    out << part1(game, ranked) << part2(game, ranked);
+}
+
+/**
+ * main function
+ */
+const auto daySolver = aoc::makeSolver(
+    aoc::cached("day07/1", parse, save, load), part1, part2, stream);
+
+const aoc::Solver& solver() { return daySolver; }
+
+/**
+ *--- Day 7: Camel Cards ---
+ *
+ * Your all-expenses-paid trip turns out to be a one-way, five-minute ride in
+ *an airship. (At least it's a cool airship!) It drops you off at the edge of
+ *a vast desert and descends back to Island Island.
+ *
+ * "Did you bring the parts?"
+ *
+ * You turn around to see an Elf completely covered in white clothing, wearing
+ * goggles, and riding a large camel.
+ *
+ * "Did you bring the parts?" she asks again, louder this time. You aren't
+ *sure what parts she's looking for; you're here to figure out why the sand
+ *stopped.
+ *
+ * "The parts! For the sand, yes! Come with me; I will show you." She beckons
+ *  you onto the camel.
+ *
+ * After riding a bit across the sands of Desert Island, you can see what look
+ * like very large rocks covering half of the horizon. The Elf explains that
+ *the rocks are all along the part of Desert Island that is directly above
+ *Island Island, making it hard to even get there. Normally, they use big
+ *machines to move the rocks and filter the sand, but the machines have broken
+ *down because Desert Island recently stopped receiving the parts they need to
+ *fix the machines.
+ *
+ * You've already assumed it'll be your job to figure out why the parts
+ *stopped when she asks if you can help. You agree automatically.
+ *
+ * Because the journey will take a few days, she offers to teach you the game
+ *of Camel Cards. Camel Cards is sort of similar to poker except it's designed
+ *to be easier to play while riding a camel.
+ *
+ * In Camel Cards, you get a list of hands, and your goal is to order them
+ *based on the strength of each hand. A hand consists of five cards labeled
+ *one of A, K, Q, J, T, 9, 8, 7, 6, 5, 4, 3, or 2. The relative strength of
+ *each card follows this order, where A is the highest and 2 is the lowest.
+ *
+ * Every hand is exactly one type. From strongest to weakest, they are:
+ *
+ * Five of a kind, where all five cards have the same label: AAAAA
+ * Four of a kind, where four cards have the same label and one card has a
+ * different label: AA8AA Full house, where three cards have the same label,
+ *and the remaining two cards share a different label: 23332 Three of a kind,
+ *where three cards have the same label, and the remaining two cards are each
+ * different from any other card in the hand: TTT98 Two pair, where two cards
+ * share one label, two other cards share a second label, and the remaining
+ *card has a third label: 23432 One pair, where two cards share one label, and
+ *the other three cards have a different label from the pair and each other:
+ *A23A4 High card, where all cards' labels are distinct: 23456
+ *
+ * Hands are primarily ordered based on type; for example, every full house is
+ * stronger than any three of a kind.
+ *
+ * If two hands have the same type, a second ordering rule takes effect. Start
+ * by comparing the first card in each hand. If these cards are different, the
+ * hand with the stronger first card is considered stronger. If the first card
+ * in each hand have the same label, however, then move on to considering the
+ * second card in each hand. If they differ, the hand with the higher second
+ * card wins; otherwise, continue with the third card in each hand, then the
+ * fourth, then the fifth.
+ *
+ * So, 33332 and 2AAAA are both four of a kind hands, but 33332 is stronger
+ * because its first card is stronger. Similarly, 77888 and 77788 are both a
+ * full house, but 77888 is stronger because its third card is stronger (and
+ * both hands have the same first and second card).
+ *
+ * To play Camel Cards, you are given a list of hands and their corresponding
+ * bid (your puzzle input). For example:
+ *
+ * 32T3K 765
+ * T55J5 684
+ * KK677 28
+ * KTJJT 220
+ * QQQJA 483
+ *
+ * This example shows five hands; each hand is followed by its bid amount.
+ * Each hand wins an amount equal to its bid multiplied by its rank, where the
+ * weakest hand gets rank 1, the second-weakest hand gets rank 2, and so on up
+ * to the strongest hand. Because there are five hands in this example, the
+ * strongest hand will have rank 5 and its bid will be multiplied by 5.
+ *
+ * So, the first step is to put the hands in order of strength:
+ *
+ * 32T3K is the only one pair and the other hands are all a stronger type,
+ * so it gets rank 1. KK677 and KTJJT are both two pair. Their first cards
+ * both have the same label, but the second card of KK677 is stronger (K vs T),
+ * so KTJJT gets rank 2 and KK677 gets rank 3. T55J5 and QQQJA are both three
+ * of a kind. QQQJA has a stronger first card, so it gets rank 5 and T55J5 gets
+ * rank 4.
+ *
+ * Now, you can determine the total winnings of this set of hands by adding up
+ * the result of multiplying each hand's bid with its rank (765 * 1 + 220 * 2
+ *+ 28 * 3 + 684 * 4 + 483 * 5). So the total winnings in this example are
+ * 6440.
+ *
+ * Find the rank of every hand in your set. What are the total winnings?
+ *
+ *                              --- Part Two ---
+ * To make things a little more interesting, the Elf introduces one additional
+ * rule. Now, J cards are jokers - wildcards that can act like whatever card
+ * would make the hand the strongest type possible.
+ *
+ * To balance this, J cards are now the weakest individual cards, weaker even
+ * than 2. The other cards stay in the same order: A, K, Q, T, 9, 8, 7, 6, 5, 4,
+ * 3, 2, J.
+ *
+ * J cards can pretend to be whatever card is best for the purpose of
+ * determining hand type; for example, QJJQ2 is now considered four of a kind.
+ * However, for the purpose of breaking ties between two hands of the same type,
+ * J is always treated as J, not the card it's pretending to be: JKKK2 is weaker
+ * than QQQQ2 because J is weaker than Q.
+ *
+ * Now, the above example goes very differently:
+ *
+ * 32T3K 765
+ * T55J5 684
+ * KK677 28
+ * KTJJT 220
+ * QQQJA 483
+ *
+ * 32T3K is still the only one pair; it doesn't contain any jokers, so its
+ * strength doesn't increase. KK677 is now the only two pair, making it the
+ * second-weakest hand. T55J5, KTJJT, and QQQJA are now all four of a kind!
+ * T55J5 gets rank 3, QQQJA gets rank 4, and KTJJT gets rank 5.
+ *
+ * With the new joker rule, the total winnings in this example are 5905.
+ *
+ * Using the new joker rule, find the rank of every hand in your set. What are
+ *the new total winnings?
+ *
+ */
+
+}  // namespace day07
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day 7: Camel Cards
+ */
+namespace day07 {
+    const aoc::Solver& solver();
+}  // namespace day07
@@ -0,0 +1,331 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/arena.h"
+#include "../common/input.h"
+#include "../common/instrument.h"
+#include "../common/model_cache.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "../common/tokenize.h"
+#include "day.h"
+
+namespace day08 {
+
+/**
+ * Directions plus the network, parsed once for both parts. Nodes are
+ * numbered in the order the input first names them, and each node's
+ * neighbours are numbers too, so a step is two array reads instead of a
+ * lookup by name.
+ */
+struct wastelandMap {
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    std::string directions;
+    std::pmr::vector<uint32_t> left {aoc::arena()};
+    std::pmr::vector<uint32_t> right {aoc::arena()};
+    // 1 for the nodes whose name ends in Z
+    std::pmr::vector<uint8_t> endsInZ {aoc::arena()};
+    // nodes ending in A, in input order
+    std::pmr::vector<uint32_t> starts {aoc::arena()};
+    // AAA and ZZZ, NONE when the network has no such node
+    uint32_t first = NONE;
+    uint32_t last = NONE;
+};
+
+wastelandMap parse(const aoc::Input& input) {
+    aoc::Lines lines = input.lines();
+    wastelandMap wasteland;
+
+    std::string_view line;
+    lines.next(line);
+    wasteland.directions = line;
+
+    // names only matter while parsing; they point into the input
+    std::pmr::unordered_map<std::string_view, uint32_t> numbers {
+        aoc::arena()};
+    // a node that's named but never given leads back to itself
+    auto number = [&](std::string_view name) {
+        auto [entry, added] = numbers.try_emplace(name, numbers.size());
+        if (added) {
+            wasteland.left.push_back(entry->second);
+            wasteland.right.push_back(entry->second);
+            wasteland.endsInZ.push_back(name.back() == 'Z');
+            if (name == "AAA") wasteland.first = entry->second;
+            if (name == "ZZZ") wasteland.last = entry->second;
+        }
+        return entry->second;
+    };
+
+    aoc::Tokens tokens;
+    while (lines.next(line)) {
+        if (line.empty()) continue;
+
+        aoc::tokenize(line, tokens);
+        std::string_view from = tokens[0];
+        uint32_t node = number(from);
+        uint32_t left = number(tokens[2].substr(1, 3));
+        uint32_t right = number(tokens[3].substr(0, 3));
+
+        if (from.back() == 'A') wasteland.starts.push_back(node);
+
+        wasteland.left[node] = left;
+        wasteland.right[node] = right;
+    }
+
+    return wasteland;
+}
+
+/**
+ * Model cache, the directions and the numbered network as it's held
+ */
+void save(const wastelandMap& wasteland, aoc::ModelWriter& out) {
+    out.putString(wasteland.directions);
+    out.putArray(wasteland.left);
+    out.putArray(wasteland.right);
+    out.putArray(wasteland.endsInZ);
+    out.putArray(wasteland.starts);
+    out.put(wasteland.first);
+    out.put(wasteland.last);
+}
+
+wastelandMap load(aoc::ModelReader& in) {
+    wastelandMap wasteland;
+    in.getString(wasteland.directions);
+    in.getArray(wasteland.left);
+    in.getArray(wasteland.right);
+    in.getArray(wasteland.endsInZ);
+    in.getArray(wasteland.starts);
+    in.get(wasteland.first);
+    in.get(wasteland.last);
+
+    // every number has to name a node, or a walk would read past the end
+    size_t nodes = wasteland.left.size();
+    auto valid = [nodes](uint32_t node) { return node < nodes; };
+    auto noneOrValid = [nodes](uint32_t node) {
+        return node == wastelandMap::NONE || node < nodes;
+    };
+    if (wasteland.right.size() != nodes ||
+        wasteland.endsInZ.size() != nodes ||
+        !std::all_of(wasteland.left.begin(), wasteland.left.end(), valid) ||
+        !std::all_of(wasteland.right.begin(), wasteland.right.end(), valid) ||
+        !std::all_of(wasteland.starts.begin(), wasteland.starts.end(),
+                     valid) ||
+        !noneOrValid(wasteland.first) || !noneOrValid(wasteland.last))
+        in.fail();
+    return wasteland;
+}
+
+/**
+ * Most steps a walk can take before it's going round in circles: past
+ * there it has been at some node with the directions at the same place
+ * twice, so if it hasn't reached the end yet it never will
+ */
+long stepLimit(const wastelandMap& wasteland) {
+    return static_cast<long>(wasteland.left.size()) *
+           wasteland.directions.length();
+}
+
+/**
+ * Part 1
+ *
+ * 0 steps when there's no getting from AAA to ZZZ
+ */
+aoc::Answer part1(const wastelandMap& wasteland) {
+    const std::string& directions = wasteland.directions;
+    const int DIRECTIONS_END = directions.length();
+
+    int index = 0;
+    long steps = 0;
+
+    bool traversingDesert = true;
+
+    // We start at AAA
+    uint32_t location = wasteland.first;
+    if (location == wastelandMap::NONE) traversingDesert = false;
+    const long STEP_LIMIT = stepLimit(wasteland);
+
+    while (traversingDesert) {
+        if (steps == STEP_LIMIT) {
+            steps = 0;
+            break;
+        }
+
+        if (directions[index] == 'L') location = wasteland.left[location];
+        else
+            location = wasteland.right[location];
+
+        steps++;
+        if (location == wasteland.last) traversingDesert = false;
+
+        index++;
+        if (index >= DIRECTIONS_END) index = 0;
+    }
+
+    return {"Part 1: Number of steps to reach the end is ", steps};
+}
+
+/**
+ * Part 2
+ *
+ * A ghost that never reaches a Z takes 0 steps, and so do all of them
+ */
+
+
+long ghost(uint32_t location, const wastelandMap& wasteland) {
+    const std::string& directions = wasteland.directions;
+    int index = 0;
+    long steps = 0;
+    bool traversingDesert = true;
+    const int DIRECTIONS_END = directions.length();
+    const long STEP_LIMIT = stepLimit(wasteland);
+
+    while (traversingDesert) {
+        if (steps == STEP_LIMIT) return 0;
+        AOC_COUNT("steps", 1);
+        if (directions[index] == 'L') location = wasteland.left[location];
+        else
+            location = wasteland.right[location];
+
+        steps++;
+        if (wasteland.endsInZ[location]) traversingDesert = false;
+
+        index++;
+        if (index >= DIRECTIONS_END) index = 0;
+    }
+
+    return steps;
+}
+
+aoc::Answer part2(const wastelandMap& wasteland) {
+    // every ghost loops, so they all land on a Z together after the lcm of
+    // their steps; folding it in as each one finishes keeps no list
+    long result = 1;
+    for (uint32_t location : wasteland.starts) {
+        long steps = ghost(location, wasteland);
+        result = std::lcm(result, steps);
+    }
+
+    return {"Part 2: Number of steps to reach the end is ", result};
+}
+
+/**
+ * main function
+ */
+const auto daySolver = aoc::makeSolver(
+    aoc::cached("day08/2", parse, save, load), part1, part2);
+
+const aoc::Solver& solver() { return daySolver; }
+
+/**
+ *                      --- Day 8: Haunted Wasteland ---
+ * You're still riding a camel across Desert Island when you spot a sandstorm
+ * quickly approaching. When you turn to warn the Elf, she disappears before
+ * your eyes! To be fair, she had just finished warning you about ghosts a few
+ * minutes ago.
+ *
+ * One of the camel's pouches is labeled "maps" - sure enough, it's full of
+ * documents (your puzzle input) about how to navigate the desert. At least,
+ * you're pretty sure that's what they are; one of the documents contains a list
+ * of left/right instructions, and the rest of the documents seem to describe
+ * some kind of network of labeled nodes.
+ *
+ * It seems like you're meant to use the left/right instructions to navigate the
+ * network. Perhaps if you have the camel follow the same instructions, you can
+ * escape the haunted wasteland!
+ *
+ * After examining the maps for a bit, two nodes stick out: AAA and ZZZ. You
+ * feel like AAA is where you are now, and you have to follow the left/right
+ * instructions until you reach ZZZ.
+ *
+ * This format defines each node of the network individually. For example:
+ *
+ * RL
+ *
+ * AAA = (BBB, CCC)
+ * BBB = (DDD, EEE)
+ * CCC = (ZZZ, GGG)
+ * DDD = (DDD, DDD)
+ * EEE = (EEE, EEE)
+ * GGG = (GGG, GGG)
+ * ZZZ = (ZZZ, ZZZ)
+ *
+ * Starting with AAA, you need to look up the next element based on the next
+ * left/right instruction in your input. In this example, start with AAA and go
+ * right (R) by choosing the right element of AAA, CCC. Then, L means to choose
+ * the left element of CCC, ZZZ. By following the left/right instructions, you
+ * reach ZZZ in 2 steps.
+ *
+ * Of course, you might not find ZZZ right away. If you run out of left/right
+ * instructions, repeat the whole sequence of instructions as necessary: RL
+ * really means RLRLRLRLRLRLRLRL... and so on. For example, here is a situation
+ * that takes 6 steps to reach ZZZ:
+ *
+ * LLR
+ *
+ * AAA = (BBB, BBB)
+ * BBB = (AAA, ZZZ)
+ * ZZZ = (ZZZ, ZZZ)
+ *
+ * Starting at AAA, follow the left/right instructions. How many steps are
+ * required to reach ZZZ?
+ *
+ *                            -- Part Two ---
+ * The sandstorm is upon you and you aren't any closer to escaping the
+ * wasteland. You had the camel follow the instructions, but you've barely left
+ * your starting position. It's going to take significantly more steps to
+ * escape!
+ *
+ * What if the map isn't for people - what if the map is for ghosts? Are ghosts
+ * even bound by the laws of spacetime? Only one way to find out.
+ *
+ * After examining the maps a bit longer, your attention is drawn to a curious
+ * fact: the number of nodes with names ending in A is equal to the number
+ * ending in Z! If you were a ghost, you'd probably just start at every node
+ * that ends with A and follow all of the paths at the same time until they all
+ * simultaneously end up at nodes that end with Z.
+ *
+ * For example:
+ *
+ * LR
+ *
+ * 11A = (11B, XXX)
+ * 11B = (XXX, 11Z)
+ * 11Z = (11B, XXX)
+ * 22A = (22B, XXX)
+ * 22B = (22C, 22C)
+ * 22C = (22Z, 22Z)
+ * 22Z = (22B, 22B)
+ * XXX = (XXX, XXX)
+ *
+ * Here, there are two starting nodes, 11A and 22A (because they both end with
+ * A). As you follow each left/right instruction, use that instruction to
+ * simultaneously navigate away from both nodes you're currently on. Repeat this
+ * process until all of the nodes you're currently on end with Z. (If only some
+ * of the nodes you're on end with Z, they act like any other node and you
+ * continue as normal.) In this example, you would proceed as follows:
+ *
+ *     Step 0: You are at 11A and 22A.
+ *     Step 1: You choose all of the left paths, leading you to 11B and 22B.
+ *     Step 2: You choose all of the right paths, leading you to 11Z and 22C.
+ *     Step 3: You choose all of the left paths, leading you to 11B and 22Z.
+ *     Step 4: You choose all of the right paths, leading you to 11Z and 22B.
+ *     Step 5: You choose all of the left paths, leading you to 11B and 22C.
+ *     Step 6: You choose all of the right paths, leading you to 11Z and 22Z.
+ *
+ * So, in this example, you end up entirely on nodes that end in Z after 6
+ * steps.
+ *
+ * Simultaneously start on every node that ends with A. How many steps does it
+ * take before you're only on nodes that end with Z?
+ *
+ */
+
+}  // namespace day08
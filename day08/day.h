@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day 8: Haunted Wasteland
+ */
+namespace day08 {
+    const aoc::Solver& solver();
+}  // namespace day08
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/arena.h"
+#include "../common/input.h"
+#include "../common/parallel.h"
+#include "../common/parse_int.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "../common/tokenize.h"
+#include "day.h"
+
+namespace day09 {
+
+/**
+ * Part 1
+ */
+// pmr so the parsed histories can live in the run's arena; sequences made
+// while solving use the default resource
+using sequence = std::pmr::vector<long>;
+using historyList = std::pmr::vector<sequence>;
+
+// histories per chunk when a part splits them across cores
+const size_t HISTORY_CHUNK = 1024;
+
+void printVector(std::vector<long> seq) {
+    std::cout << "{ ";
+    for (auto& num : seq) std::cout << num << " ";
+    std::cout << " }\n";
+}
+
+/**
+ * Each row of differences is worked out over the row before it, in one
+ * buffer with room for the whole history, adding its end to the answer as
+ * it goes: the last value for part 1, the first ones alternately added and
+ * taken away for part 2.
+ */
+long findNextValue(const sequence& seq, bool isPart1, long* differences) {
+    std::copy(seq.begin(), seq.end(), differences);
+
+    long nextValue = 0;
+    long sign = 1;
+    bool allZeros = false;
+    for (size_t count = seq.size(); count > 0 && !allZeros; count--) {
+        if (isPart1) {
+            nextValue += differences[count - 1];
+        } else {
+            nextValue += sign * differences[0];
+            sign = -sign;
+        }
+
+        allZeros = true;
+        for (size_t i = 0; i + 1 < count; i++) {
+            differences[i] = differences[i + 1] - differences[i];
+            if (differences[i] != 0) allZeros = false;
+        }
+    }
+    return nextValue;
+}
+
+/**
+ * Parsing
+ */
+void parseHistory(std::string_view line, aoc::Tokens& tokens,
+                  sequence& history) {
+    aoc::tokenize(line, tokens);
+    for (auto& token : tokens)
+        history.push_back(aoc::toInt<long>(token));
+}
+
+historyList parse(const aoc::Input& input) {
+    aoc::Lines lines = input.lines();
+    historyList histories(aoc::arena());
+
+    std::string_view line;
+    aoc::Tokens tokens;
+    while (lines.next(line)) {
+        // picks up the arena from histories
+        histories.emplace_back();
+        parseHistory(line, tokens, histories.back());
+    }
+
+    return histories;
+}
+
+/**
+ * Sum of every history's extrapolated value, the histories being
+ * independent of each other. Each chunk differences in its own stretch of
+ * space, as long as the longest history; space is scratch from the
+ * caller's workspace, so solving again reuses it.
+ */
+long sumNextValues(const historyList& histories, bool isPart1,
+                   std::vector<long>& space) {
+    size_t longest = 0;
+    for (const sequence& history : histories)
+        longest = std::max(longest, history.size());
+    size_t chunks = (histories.size() + HISTORY_CHUNK - 1) / HISTORY_CHUNK;
+    space.resize(chunks * longest);
+
+    return aoc::parallelReduce(
+        histories.size(), HISTORY_CHUNK, 0L,
+        [&](long& sum, size_t begin, size_t end) {
+            long* differences =
+                space.data() + begin / HISTORY_CHUNK * longest;
+            for (size_t i = begin; i < end; i++)
+                sum += findNextValue(histories[i], isPart1, differences);
+        },
+        [](long& all, long chunk) { all += chunk; });
+}
+
+aoc::Answer part1(const historyList& histories, std::vector<long>& space) {
+    long result = sumNextValues(histories, true, space);
+
+    return {"Part 1: Next value for each history is ", result};
+}
+
+/**
+ * Part 2
+ */
+aoc::Answer part2(const historyList& histories, std::vector<long>& space) {
+    long result = sumNextValues(histories, false, space);
+
+    return {"Part 2: Next value for each history is ", result};
+}
+
+/**
+ * Streaming
+ *
+ * Every history is extrapolated on its own, so both sums are built up one
+ * line at a time
+ */
+void stream(aoc::LineStream& lines, std::ostream& out) {
+    long result1 = 0;
+    long result2 = 0;
+
+    std::string_view line;
+    aoc::Tokens tokens;
+    sequence history;
+    std::vector<long> differences;
+    while (lines.next(line)) {
+        history.clear();
+        parseHistory(line, tokens, history);
+        if (differences.size() < history.size())
+            differences.resize(history.size());
+        result1 += findNextValue(history, true, differences.data());
+        result2 += findNextValue(history, false, differences.data());
+    }
+
+    out << aoc::Answer("Part 1: Next value for each history is ", result1);
+    out << aoc::Answer("Part 2: Next value for each history is ", result2);
+}
+
+/**
+ * main function
+ */
+const auto daySolver = aoc::makeSolver(parse, part1, part2, stream);
+
+const aoc::Solver& solver() { return daySolver; }
+
+
+/**
+ *                     --- Day 9: Mirage Maintenance ---
+ *
+ * You ride the camel through the sandstorm and stop where the ghost's maps told
+ * you to stop. The sandstorm subsequently subsides, somehow seeing you standing
+ * at an oasis!
+ *
+ * The camel goes to get some water and you stretch your neck. As you look up,
+ * you discover what must be yet another giant floating island, this one made of
+ * metal! That must be where the parts to fix the sand machines come from.
+ *
+ * There's even a hang glider partially buried in the sand here; once the sun
+ * rises and heats up the sand, you might be able to use the glider and the hot
+ * air to get all the way up to the metal island!
+ *
+ * While you wait for the sun to rise, you admire the oasis hidden here in the
+ * middle of Desert Island. It must have a delicate ecosystem; you might as well
+ * take some ecological readings while you wait. Maybe you can report any
+ * environmental instabilities you find to someone so the oasis can be around
+ * for the next sandstorm-worn traveler.
+ *
+ * You pull out your handy Oasis And Sand Instability Sensor and analyze your
+ * surroundings. The OASIS produces a report of many values and how they are
+ * changing over time (your puzzle input). Each line in the report contains the
+ * history of a single value. For example:
+ *
+ * 0 3 6 9 12 15
+ * 1 3 6 10 15 21
+ * 10 13 16 21 30 45
+ *
+ * To best protect the oasis, your environmental report should include a
+ * prediction of the next value in each history. To do this, start by making a
+ * new sequence from the difference at each step of your history. If that
+ * sequence is not all zeroes, repeat this process, using the sequence you just
+ * generated as the input sequence. Once all of the values in your latest
+ * sequence are zeroes, you can extrapolate what the next value of the original
+ * history should be.
+ *
+ * In the above dataset, the first history is 0 3 6 9 12 15. Because the values
+ * increase by 3 each step, the first sequence of differences that you generate
+ * will be 3 3 3 3 3. Note that this sequence has one fewer value than the input
+ * sequence because at each step it considers two numbers from the input. Since
+ * these values aren't all zero, repeat the process: the values differ by 0 at
+ * each step, so the next sequence is 0 0 0 0. This means you have enough
+ * information to extrapolate the history! Visually, these sequences can be
+ * arranged like this:
+ *
+ * 0   3   6   9  12  15
+ *   3   3   3   3   3
+ *     0   0   0   0
+ *
+ * To extrapolate, start by adding a new zero to the end of your list of zeroes;
+ * because the zeroes represent differences between the two values above them,
+ * this also means there is now a placeholder in every sequence above it:
+ *
+ * 0   3   6   9  12  15   B
+ *   3   3   3   3   3   A
+ *     0   0   0   0   0
+ *
+ * You can then start filling in placeholders from the bottom up. A needs to be
+ * the result of increasing 3 (the value to its left) by 0 (the value below it);
+ * this means A must be 3:
+ *
+ * 0   3   6   9  12  15   B
+ *   3   3   3   3   3   3
+ *     0   0   0   0   0
+ *
+ * Finally, you can fill in B, which needs to be the result of increasing 15
+ * (the value to its left) by 3 (the value below it), or 18:
+ *
+ * 0   3   6   9  12  15  18
+ *   3   3   3   3   3   3
+ *     0   0   0   0   0
+ *
+ * So, the next value of the first history is 18.
+ *
+ * Finding all-zero differences for the second history requires an additional
+ * sequence:
+ *
+ * 1   3   6  10  15  21
+ *   2   3   4   5   6
+ *     1   1   1   1
+ *       0   0   0
+ *
+ * Then, following the same process as before, work out the next value in each
+ * sequence from the bottom up:
+ *
+ * 1   3   6  10  15  21  28
+ *   2   3   4   5   6   7
+ *     1   1   1   1   1
+ *       0   0   0   0
+ *
+ * So, the next value of the second history is 28.
+ *
+ * The third history requires even more sequences, but its next value can be
+ * found the same way:
+ *
+ * 10  13  16  21  30  45  68
+ *    3   3   5   9  15  23
+ *      0   2   4   6   8
+ *        2   2   2   2
+ *          0   0   0
+ *
+ * So, the next value of the third history is 68.
+ *
+ * If you find the next value for each history in this example and add them
+ * together, you get 114.
+ *
+ * Analyze your OASIS report and extrapolate the next value for each history.
+ * What is the sum of these extrapolated values?
+ *
+ *                             --- Part Two ---
+ * Of course, it would be nice to have even more history included in your
+ * report. Surely it's safe to just extrapolate backwards as well, right?
+ *
+ * For each history, repeat the process of finding differences until the
+ * sequence of differences is entirely zero. Then, rather than adding a zero to 
+ * the end and filling in the next values of each previous sequence, you should 
+ * instead add a zero to the beginning of your sequence of zeroes, then fill in 
+ * new first values for each previous sequence.
+ *
+ * In particular, here is what the third example history looks like when
+ * extrapolating back in time:
+ *
+ * 5  10  13  16  21  30  45
+ *   5   3   3   5   9  15
+ *    -2   0   2   4   6
+ *       2   2   2   2
+ *         0   0   0
+ *
+ * Adding the new values on the left side of each sequence from bottom to top
+ * eventually reveals the new left-most history value: 5.
+ *
+ * Doing this for the remaining example data above results in previous values of
+ * -3 for the first history and 0 for the second history. Adding all three new 
+ * values together produces 2.
+ *
+ * Analyze your OASIS report again, this time extrapolating the previous value 
+ * for each history. What is the sum of these extrapolated values?
+ */
+
+}  // namespace day09
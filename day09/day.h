@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day 9: Mirage Maintenance
+ */
+namespace day09 {
+    const aoc::Solver& solver();
+}  // namespace day09
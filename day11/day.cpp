@@ -0,0 +1,446 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <utility>
+#include <vector>
+
+#include "../common/arena.h"
+#include "../common/grid.h"
+#include "../common/input.h"
+#include "../common/instrument.h"
+#include "../common/model_cache.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "day.h"
+
+namespace day11 {
+
+/**
+ * Declarations/Structs
+ */
+using grid = aoc::Grid2D<char>;
+const ulong EXPANSION_SIZE = 1;
+
+struct expansionLines {
+    std::pmr::vector<int> rows;
+    std::pmr::vector<int> columns;
+    expansionLines(std::pmr::vector<int> r, std::pmr::vector<int> c)
+        : rows(std::move(r)), columns(std::move(c)) {}
+};
+
+struct position {
+    ulong row, col;
+    position(ulong r, ulong c) : row(r), col(c) {}
+    position() : row(-1), col(-1) {}
+    bool operator==(const position& other) {
+        return row == other.row && col == other.col;
+    }
+    bool operator!=(const position& other) {
+        return row != other.row || col != other.col;
+    }
+
+    void operator=(const position& other) {
+        row = other.row;
+        col = other.col;
+    }
+};
+
+void printGrid(const grid& grid) {
+    for (int r = 0; r < grid.height(); r++) {
+        for (char ch : grid.row(r)) { std::cout << ch; }
+        std::cout << std::endl;
+    }
+}
+
+std::pmr::vector<position> findGalaxies(const grid& u) {
+    std::pmr::vector<position> galaxies(aoc::arena());
+    for (int row = 0; row < u.height(); row++) {
+        for (int col = 0; col < u.width(); col++) {
+            if (u(row, col) != '.') galaxies.push_back(position(row, col));
+        }
+    }
+
+    return galaxies;
+}
+
+ulong getDistanceBetweenPoints(position p1, position p2) {
+    ulong sum1, sum2;
+    if (p1.col > p2.col) sum1 = p1.col - p2.col;
+    else
+        sum1 = p2.col - p1.col;
+
+    if (p1.row > p2.row) sum2 = p1.row - p2.row;
+    else
+        sum2 = p2.row - p1.row;
+
+    return sum1 + sum2;
+}
+
+bool isEmpty(aoc::GridLine<const char> line) {
+    return std::all_of(line.begin(), line.end(),
+                       [](char ch) { return ch == '.'; });
+}
+
+expansionLines getLines(const grid& universe) {
+    std::pmr::vector<int> rowsThatNeedExpanding(aoc::arena());
+    std::pmr::vector<int> columnsThatNeedExpanding(aoc::arena());
+
+    for (int row = 0; row < universe.height(); row++) {
+        if (isEmpty(universe.row(row))) rowsThatNeedExpanding.push_back(row);
+    }
+
+    for (int col = 0; col < universe.width(); col++) {
+        if (isEmpty(universe.column(col)))
+            columnsThatNeedExpanding.push_back(col);
+    }
+    return expansionLines(std::move(rowsThatNeedExpanding),
+                          std::move(columnsThatNeedExpanding));
+}
+/**
+ * The image parsed once: the galaxies and the empty rows and columns, all
+ * in the run's arena
+ */
+struct image {
+    std::pmr::vector<position> galaxies;
+    expansionLines lines;
+    // every galaxy's row and column, each list sorted, for the fast path
+    std::pmr::vector<ulong> galaxyRows {aoc::arena()};
+    std::pmr::vector<ulong> galaxyColumns {aoc::arena()};
+
+    image(std::pmr::vector<position> g, expansionLines l)
+        : galaxies(std::move(g)), lines(std::move(l)) {}
+};
+
+image makeImage(std::pmr::vector<position> galaxies, expansionLines lines) {
+    image picture(std::move(galaxies), std::move(lines));
+    for (const position& galaxy : picture.galaxies) {
+        picture.galaxyRows.push_back(galaxy.row);
+        picture.galaxyColumns.push_back(galaxy.col);
+    }
+    std::sort(picture.galaxyRows.begin(), picture.galaxyRows.end());
+    std::sort(picture.galaxyColumns.begin(), picture.galaxyColumns.end());
+    return picture;
+}
+
+void positionsAfterExpanding(position& from, position& to,
+                             const expansionLines& lines, ulong expansionSize) {
+    int expansionRowFrom = 0;
+    int expansionColFrom = 0;
+    int expansionRowTo = 0;
+    int expansionColTo = 0;
+
+    for (auto& rowToExpand : lines.rows) {
+        if (from.row > rowToExpand) expansionRowFrom++;
+        if (to.row > rowToExpand) expansionRowTo++;
+    }
+
+    for (auto& columnToExpand : lines.columns) {
+        if (from.col > columnToExpand) expansionColFrom++;
+        if (to.col > columnToExpand) expansionColTo++;
+    }
+
+    from.col = from.col + (expansionColFrom * expansionSize);
+    from.row = from.row + (expansionRowFrom * expansionSize);
+
+    to.col = to.col + (expansionColTo * expansionSize);
+    to.row = to.row + (expansionRowTo * expansionSize);
+}
+
+/**
+ * Parsing
+ */
+image parse(const aoc::Input& input) {
+    grid universe = aoc::readGrid(input, '.');
+
+    std::pmr::vector<position> galaxies = findGalaxies(universe);
+    expansionLines lines = getLines(universe);
+
+    return makeImage(std::move(galaxies), std::move(lines));
+}
+
+/**
+ * Model cache, the galaxies as row and column pairs and the empty lines
+ */
+void save(const image& picture, aoc::ModelWriter& out) {
+    std::vector<ulong> coordinates;
+    for (const position& galaxy : picture.galaxies) {
+        coordinates.push_back(galaxy.row);
+        coordinates.push_back(galaxy.col);
+    }
+    out.putArray(coordinates);
+    out.putArray(picture.lines.rows);
+    out.putArray(picture.lines.columns);
+}
+
+image load(aoc::ModelReader& in) {
+    std::vector<ulong> coordinates;
+    in.getArray(coordinates);
+    std::pmr::vector<position> galaxies(aoc::arena());
+    for (size_t i = 0; i + 1 < coordinates.size(); i += 2)
+        galaxies.push_back(position(coordinates[i], coordinates[i + 1]));
+
+    std::pmr::vector<int> rows(aoc::arena()), columns(aoc::arena());
+    in.getArray(rows);
+    in.getArray(columns);
+    return makeImage(std::move(galaxies),
+                     expansionLines(std::move(rows), std::move(columns)));
+}
+
+/**
+ * Fast path
+ *
+ * A distance is a row part plus a column part, so each axis sums on its
+ * own. With an axis's coordinates sorted, the k-th one is the far end of k
+ * pairs, so it adds k times itself less the sum of everything before it.
+ * That makes the whole sum O(n log n) in galaxies instead of a loop over
+ * every pair, the sorting done once in makeImage().
+ */
+long sumOfSpans(const std::pmr::vector<ulong>& coordinates,
+                const std::pmr::vector<int>& emptyLines,
+                ulong expansionSize) {
+    // emptyLines is ascending too, so walk them alongside
+    size_t emptyBefore = 0;
+    long sum = 0;
+    long before = 0;
+    for (size_t k = 0; k < coordinates.size(); k++) {
+        while (emptyBefore < emptyLines.size()
+               && static_cast<ulong>(emptyLines[emptyBefore]) < coordinates[k])
+            emptyBefore++;
+        long expanded = coordinates[k] + emptyBefore * expansionSize;
+        sum += expanded * static_cast<long>(k) - before;
+        before += expanded;
+    }
+    return sum;
+}
+
+long sumOfDistances(const image& picture, ulong expansionSize) {
+    return sumOfSpans(picture.galaxyRows, picture.lines.rows, expansionSize)
+           + sumOfSpans(picture.galaxyColumns, picture.lines.columns,
+                        expansionSize);
+}
+
+/**
+ * Part 1
+ */
+aoc::Answer part1(const image& picture) {
+    long sum = sumOfDistances(picture, 1);
+    return {"Part 1: Sum of lowest distance between galaxies is ", sum};
+}
+
+aoc::Answer part1Reference(const image& picture) {
+    const std::pmr::vector<position>& galaxies = picture.galaxies;
+    const expansionLines& lines = picture.lines;
+
+    std::vector<position> done;
+    long sum = 0;
+    for (auto from : galaxies) {
+        for (auto to : galaxies) {
+            if (from != to
+                && std::find(done.begin(), done.end(), to) == done.end()) {
+                position gf = from;
+                position gt = to;
+                positionsAfterExpanding(gf, gt, lines, 1);
+                long d = getDistanceBetweenPoints(gf, gt);
+                sum += d;
+            }
+        }
+        AOC_COUNT("pairs evaluated", galaxies.size());
+        done.push_back(from);
+    }
+
+    return {"Part 1: Sum of lowest distance between galaxies is ", sum};
+}
+
+/**
+ * Part 2
+ */
+aoc::Answer part2(const image& picture) {
+    long sum = sumOfDistances(picture, 999999);
+    return {"Part 2: Sum of lowest distance between galaxies is ", sum};
+}
+
+aoc::Answer part2Reference(const image& picture) {
+    const std::pmr::vector<position>& galaxies = picture.galaxies;
+    const expansionLines& lines = picture.lines;
+
+    std::vector<position> done;
+    long sum = 0;
+    for (auto from : galaxies) {
+        for (auto to : galaxies) {
+            if (from != to
+                && std::find(done.begin(), done.end(), to) == done.end()) {
+                position gf = from;
+                position gt = to;
+                positionsAfterExpanding(gf, gt, lines, 999999);
+                long d = getDistanceBetweenPoints(gf, gt);
+                sum += d;
+            }
+        }
+        AOC_COUNT("pairs evaluated", galaxies.size());
+        done.push_back(from);
+    }
+
+    return {"Part 2: Sum of lowest distance between galaxies is ", sum};
+}
+
+/**
+ * main function
+ */
+const auto daySolver = aoc::makeSolver(
+    aoc::cached("day11/2", parse, save, load), part1, part2);
+// every pair measured on its own, for fuzz/ to check the sums against
+const auto referenceSolver =
+    aoc::makeSolver(parse, part1Reference, part2Reference);
+
+const aoc::Solver& solver() { return daySolver; }
+const aoc::Solver& reference() { return referenceSolver; }
+
+/**
+ *                   --- Day 11: Cosmic Expansion ---
+ *
+ * You continue following signs for "Hot Springs" and eventually come across
+ * an observatory. The Elf within turns out to be a researcher studying
+ * cosmic expansion using the giant telescope here.
+ *
+ * He doesn't know anything about the missing machine parts; he's only
+ * visiting for this research project. However, he confirms that the hot
+ * springs are the next-closest area likely to have people; he'll even take
+ * you straight there once he's done with today's observation analysis.
+ *
+ * Maybe you can help him with the analysis to speed things up?
+ *
+ * The researcher has collected a bunch of data and compiled the data into a
+ * single giant image (your puzzle input). The image includes empty space
+ * (.) and galaxies
+ * (#). For example:
+ *
+ * ...#......
+ * .......#..
+ * #.........
+ * ..........
+ * ......#...
+ * .#........
+ * .........#
+ * ..........
+ * .......#..
+ * #...#.....
+ *
+ * The researcher is trying to figure out the sum of the lengths of the
+ * shortest path between every pair of galaxies. However, there's a catch:
+ * the universe expanded in the time it took the light from those galaxies to
+ * reach the observatory.
+ *
+ * Due to something involving gravitational effects, only some space
+ *expands. In fact, the result is that any rows or columns that contain no
+ *galaxies should all actually be twice as big.
+ *
+ * In the above example, three columns and two rows contain no galaxies:
+ *
+ *    v  v  v
+ *  ...#......
+ *  .......#..
+ *  #.........
+ * >..........<
+ *  ......#...
+ *  .#........
+ *  .........#
+ * >..........<
+ *  .......#..
+ *  #...#.....
+ *    ^  ^  ^
+ *
+ * These rows and columns need to be twice as big; the result of cosmic
+ * expansion therefore looks like this:
+ *
+ * ....#........
+ * .........#...
+ * #............
+ * .............
+ * .............
+ * ........#....
+ * .#...........
+ * ............#
+ * .............
+ * .............
+ * .........#...
+ * #....#.......
+ *
+ * Equipped with this expanded universe, the shortest path between every
+ * pair of galaxies can be found. It can help to assign every galaxy a unique
+ * number:
+ *
+ * ....1........
+ * .........2...
+ * 3............
+ * .............
+ * .............
+ * ........4....
+ * .5...........
+ * ............6
+ * .............
+ * .............
+ * .........7...
+ * 8....9.......
+ *
+ * In these 9 galaxies, there are 36 pairs. Only count each pair once; order
+ * within the pair doesn't matter. For each pair, find any shortest path
+ * between the two galaxies using only steps that move up, down, left, or
+ * right exactly one . or # at a time. (The shortest path between two
+ * galaxies is allowed to pass through another galaxy.)
+ *
+ * For example, here is one of the shortest paths between galaxies 5 and 9:
+ *
+ * ....1........
+ * .........2...
+ * 3............
+ * .............
+ * .............
+ * ........4....
+ * .5...........
+ * .##.........6
+ * ..##.........
+ * ...##........
+ * ....##...7...
+ * 8....9.......
+ *
+ * This path has length 9 because it takes a minimum of nine steps to get
+ * from galaxy 5 to galaxy 9 (the eight locations marked # plus the step onto
+ * galaxy 9 itself). Here are some other example shortest path lengths:
+ *
+ *     Between galaxy 1 and galaxy 7: 15
+ *     Between galaxy 3 and galaxy 6: 17
+ *     Between galaxy 8 and galaxy 9: 5
+ *
+ * In this example, after expanding the universe, the sum of the shortest
+ * path between all 36 pairs of galaxies is 374.
+ *
+ * Expand the universe, then find the length of the shortest path between
+ * every pair of galaxies. What is the sum of these lengths?
+ *
+ *                                 --- Part Two ---
+ * The galaxies are much older (and thus much farther apart) than the researcher
+ * initially estimated.
+ *
+ * Now, instead of the expansion you did before, make each empty row or column
+ * one million times larger. That is, each empty row should be replaced with
+ * 1000000 empty rows, and each empty column should be replaced with 1000000
+ * empty columns.
+ *
+ * (In the example above, if each empty row or column were merely 10 times
+ * larger, the sum of the shortest paths between every pair of galaxies would be
+ * 1030. If each empty row or column were merely 100 times larger, the sum of
+ * the shortest paths between every pair of galaxies would be 8410. However,
+ * your universe will need to expand far beyond these values.)
+ *
+ * Starting with the same initial image, expand the universe according to these
+ * new rules, then find the length of the shortest path between every pair of
+ * galaxies. What is the sum of these lengths?
+ *
+ *
+ */
+
+}  // namespace day11
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day 11: Cosmic Expansion
+ */
+namespace day11 {
+    const aoc::Solver& solver();
+
+    /**
+     * The solver the fast path replaced, for fuzz/ to check against
+     */
+    const aoc::Solver& reference();
+}  // namespace day11
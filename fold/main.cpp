@@ -0,0 +1,141 @@
+#include <cxxabi.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Stack folder for flamegraphs
+ *
+ * Reads the samples 'perf script' prints for a 'perf record -g' profile and
+ * writes one line per distinct call stack, root first, frames separated by
+ * ';' and followed by how many samples had that stack:
+ *
+ *     day07;main;part1;mergeSort;splitVector 412
+ *
+ * which is the folded format flamegraph.pl, speedscope and inferno all
+ * read. 'make profile' runs it, see the top-level Makefile.
+ *
+ *     perf script | main
+ *     main <perf script output>
+ *
+ * Each stack starts with the process's name. Frames lose their +0x offsets
+ * so that every sample in a function folds together, mangled names perf
+ * couldn't resolve are demangled here, and a frame with no symbol is
+ * [unknown], as perf itself calls it.
+ */
+
+/**
+ * declarations
+ */
+void readSamples(std::istream& in, std::map<std::string, long>& stacks);
+std::string frameName(const std::string& line);
+std::string demangle(const std::string& symbol);
+
+/**
+ * main function
+ */
+int main(int argc, char** argv) {
+    if (argc > 2) {
+        std::cout << "Usage: main [perf script output]\n";
+        return 1;
+    }
+
+    std::map<std::string, long> stacks;
+    if (argc == 2) {
+        std::ifstream file(argv[1]);
+        if (!file) {
+            std::cerr << "Couldn't open " << argv[1] << "\n";
+            return 1;
+        }
+        readSamples(file, stacks);
+    } else {
+        std::ios::sync_with_stdio(false);
+        readSamples(std::cin, stacks);
+    }
+
+    if (stacks.empty()) {
+        std::cerr << "No samples with call stacks; were they recorded with "
+                     "perf record -g?\n";
+        return 1;
+    }
+    for (const auto& [stack, samples] : stacks)
+        std::cout << stack << " " << samples << "\n";
+    return 0;
+}
+
+/**
+ * Folding
+ */
+
+/**
+ * Add every sample in a 'perf script' listing to stacks. A sample is a
+ * header line starting with the process's name, then its frames indented
+ * one per line from the leaf out, then a blank line.
+ */
+void readSamples(std::istream& in, std::map<std::string, long>& stacks) {
+    std::string process;
+    std::vector<std::string> frames;
+    auto fold = [&]() {
+        if (!process.empty() && !frames.empty()) {
+            std::string stack = process;
+            for (auto frame = frames.rbegin(); frame != frames.rend(); ++frame)
+                stack += ";" + *frame;
+            stacks[stack]++;
+        }
+        process.clear();
+        frames.clear();
+    };
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            fold();
+        } else if (line[0] == ' ' || line[0] == '\t') {
+            frames.push_back(frameName(line));
+        } else {
+            fold();
+            // the name runs up to the pid, which may follow several spaces
+            process = line.substr(0, line.find_first_of(" \t"));
+        }
+    }
+    fold();
+}
+
+/**
+ * The function in one frame line, "<address> <symbol>+<offset> (<object>)"
+ */
+std::string frameName(const std::string& line) {
+    size_t start = line.find_first_not_of(" \t");
+    start = line.find_first_of(" \t", start);  // past the address
+    start = line.find_first_not_of(" \t", start);
+    if (start == std::string::npos) return "[unknown]";
+
+    size_t end = line.rfind(" (");
+    if (end == std::string::npos || end < start) end = line.size();
+    std::string symbol = line.substr(start, end - start);
+
+    size_t offset = symbol.rfind("+0x");
+    if (offset != std::string::npos) symbol.erase(offset);
+    if (symbol.empty()) return "[unknown]";
+
+    symbol = demangle(symbol);
+    // ';' separates frames, so it can't appear in one
+    for (char& ch : symbol)
+        if (ch == ';') ch = ':';
+    return symbol;
+}
+
+std::string demangle(const std::string& symbol) {
+    if (symbol.compare(0, 2, "_Z") != 0) return symbol;
+    int status = 0;
+    char* readable =
+        abi::__cxa_demangle(symbol.c_str(), nullptr, nullptr, &status);
+    if (status != 0 || readable == nullptr) return symbol;
+    std::string name = readable;
+    std::free(readable);
+    return name;
+}
@@ -0,0 +1,405 @@
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/days.h"
+#include "../common/instrument_heap.h"
+#include "../gen/generators.h"
+
+/**
+ * Differential tester
+ *
+ * Checks every fast path against the implementation it replaced, which its
+ * day keeps as a second solver, reference (see aoc::findReference()).
+ * Inputs come from the generators gen/ uses, at random scales and seeds;
+ * each solver runs both parts in a child process of its own, so a crash or
+ * a hang shows up like a wrong answer would.
+ *
+ *     main [--days 5,6,10,11] [--runs N] [--seed N] [--max-scale N]
+ *          [--timeout SECONDS] [--out DIR]
+ *
+ * An input the reference can't solve is skipped, there being nothing to
+ * check against. One where the fast path fails or answers differently is
+ * shrunk before it's reported: first to the smallest scale at which the
+ * same seed still disagrees, then, for days whose inputs stay valid with
+ * lines taken out, by taking out lines for as long as it still disagrees.
+ * What's left is written to DIR/dayNN-mismatch.txt (default build/) next
+ * to the gen/ command for the input it came from, and the exit status is 1.
+ */
+
+struct options {
+    std::vector<int> days;
+    int runs = 100;
+    uint64_t seed = 1;
+    int64_t maxScale = 0;
+    unsigned timeout = 10;
+    std::string out = "build";
+};
+
+/**
+ * How to fuzz one day: its generator's scale stays below maxScale, where
+ * the reference is still quick, and removable says which lines can be
+ * taken out of an input without making it invalid (nullptr for none)
+ */
+struct target {
+    int day;
+    int64_t maxScale;
+    bool (*removable)(std::string_view line);
+};
+
+/**
+ * Both parts from one solver, or why there are none
+ */
+struct outcome {
+    bool ok = false;
+    int64_t answers[2] = {0, 0};
+    std::string failure;
+};
+
+struct trial {
+    outcome reference;
+    outcome fast;
+
+    bool disagrees() const {
+        return reference.ok &&
+               (!fast.ok || fast.answers[0] != reference.answers[0] ||
+                fast.answers[1] != reference.answers[1]);
+    }
+};
+
+/**
+ * declarations
+ */
+bool parseOptions(int argc, char** argv, options& opts);
+const target* findTarget(int day);
+std::string generate(int day, int64_t scale, uint64_t seed);
+trial compare(int day, const std::string& input, const options& opts);
+outcome solveInChild(const aoc::Solver& solver, const std::string& input,
+                     unsigned timeout);
+std::string shrinkLines(const target& fuzzed, std::string input,
+                        const options& opts);
+void report(const target& fuzzed, int64_t scale, uint64_t seed,
+            const std::string& input, const trial& result,
+            const options& opts);
+std::string dayName(int day);
+
+/**
+ * main function
+ */
+int main(int argc, char** argv) {
+    options opts;
+    if (!parseOptions(argc, argv, opts)) return 1;
+
+    randomEngine rng(opts.seed);
+    int mismatches = 0;
+    for (int day : opts.days) {
+        const target& fuzzed = *findTarget(day);
+        int64_t maxScale = fuzzed.maxScale;
+        if (opts.maxScale > 0) maxScale = std::min(maxScale, opts.maxScale);
+
+        int skipped = 0;
+        bool agreed = true;
+        for (int run = 0; run < opts.runs && agreed; run++) {
+            uint64_t seed = rng();
+            int64_t scale = between(rng, 1, maxScale);
+            trial result = compare(day, generate(day, scale, seed), opts);
+            if (!result.reference.ok) skipped++;
+            if (!result.disagrees()) continue;
+            agreed = false;
+
+            // the smallest scale with this seed that still disagrees
+            for (int64_t smaller = 1; smaller < scale; smaller++) {
+                trial again = compare(day, generate(day, smaller, seed), opts);
+                if (again.disagrees()) {
+                    scale = smaller;
+                    result = again;
+                    break;
+                }
+            }
+            std::string input = generate(day, scale, seed);
+            if (fuzzed.removable != nullptr) {
+                input = shrinkLines(fuzzed, input, opts);
+                result = compare(day, input, opts);
+            }
+            report(fuzzed, scale, seed, input, result, opts);
+            mismatches++;
+        }
+
+        if (agreed) {
+            std::cout << dayName(day) << ": " << opts.runs << " inputs agree";
+            if (skipped > 0)
+                std::cout << ", " << skipped << " the reference couldn't solve";
+            std::cout << "\n";
+        }
+    }
+
+    if (mismatches > 0) {
+        std::cout << "\n" << mismatches << " day(s) disagree\n";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Fuzzing
+ */
+bool digitFirst(std::string_view line) {
+    return !line.empty() && std::isdigit(static_cast<unsigned char>(line[0]));
+}
+
+bool anyLine(std::string_view) { return true; }
+
+/**
+ * Day 5 loses map lines but keeps its seeds and headers, day 11 can lose
+ * any row, and days 6 and 10 only shrink by scale: a race needs both its
+ * lines and a maze its whole loop
+ */
+const target targets[] = {
+    {5, 40, digitFirst},
+    {6, 8, nullptr},
+    {10, 80, nullptr},
+    {11, 140, anyLine},
+};
+
+const target* findTarget(int day) {
+    for (const target& fuzzed : targets)
+        if (fuzzed.day == day) return &fuzzed;
+    return nullptr;
+}
+
+std::string generate(int day, int64_t scale, uint64_t seed) {
+    std::ostringstream out;
+    randomEngine rng(seed);
+    generators[day - 1].write(out, scale, rng);
+    return out.str();
+}
+
+trial compare(int day, const std::string& input, const options& opts) {
+    trial result;
+    result.reference =
+        solveInChild(*aoc::findReference(day), input, opts.timeout);
+    result.fast = solveInChild(*aoc::findSolver(day), input, opts.timeout);
+    return result;
+}
+
+/**
+ * Solve both parts in a child, which sends the answers back over a pipe.
+ * This process never solves anything itself, so it never starts the
+ * reduction pool's threads and is always safe to fork.
+ */
+outcome solveInChild(const aoc::Solver& solver, const std::string& input,
+                     unsigned timeout) {
+    outcome result;
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        result.failure = std::string("pipe: ") + std::strerror(errno);
+        return result;
+    }
+
+    pid_t child = ::fork();
+    if (child < 0) {
+        result.failure = std::string("fork: ") + std::strerror(errno);
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return result;
+    }
+    if (child == 0) {
+        ::close(fds[0]);
+        ::alarm(timeout);
+        aoc::Input borrowed = aoc::Input::borrow(input);
+        std::unique_ptr<aoc::Model> model = solver.parse(borrowed, "");
+        int64_t answers[2] = {solver.solve(*model, 1).value,
+                              solver.solve(*model, 2).value};
+        bool sent = ::write(fds[1], answers, sizeof(answers)) ==
+                    static_cast<ssize_t>(sizeof(answers));
+        ::_exit(sent ? 0 : 1);
+    }
+
+    ::close(fds[1]);
+    size_t received = 0;
+    char* into = reinterpret_cast<char*>(result.answers);
+    while (received < sizeof(result.answers)) {
+        ssize_t count = ::read(fds[0], into + received,
+                               sizeof(result.answers) - received);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) break;
+        received += count;
+    }
+    ::close(fds[0]);
+
+    int status = 0;
+    while (::waitpid(child, &status, 0) < 0 && errno == EINTR) {}
+    if (WIFSIGNALED(status)) {
+        result.failure = WTERMSIG(status) == SIGALRM
+                             ? "timed out"
+                             : std::string("killed by ") +
+                                   strsignal(WTERMSIG(status));
+    } else if (received != sizeof(result.answers)) {
+        result.failure = "exited without answers";
+    }
+    result.ok = result.failure.empty();
+    return result;
+}
+
+/**
+ * Take out runs of removable lines, halving the run length whenever no run
+ * of the current length can go without the solvers agreeing again
+ */
+std::string shrinkLines(const target& fuzzed, std::string input,
+                        const options& opts) {
+    std::vector<std::string> lines;
+    std::istringstream in(input);
+    for (std::string line; std::getline(in, line);) lines.push_back(line);
+
+    auto join = [](const std::vector<std::string>& kept) {
+        std::string text;
+        for (const std::string& line : kept) text += line + "\n";
+        return text;
+    };
+
+    for (size_t run = std::max<size_t>(lines.size() / 2, 1); run >= 1;) {
+        bool removed = false;
+        for (size_t at = 0; at < lines.size();) {
+            std::vector<std::string> kept(lines.begin(), lines.begin() + at);
+            size_t end = std::min(at + run, lines.size());
+            for (size_t i = at; i < end; i++)
+                if (!fuzzed.removable(lines[i])) kept.push_back(lines[i]);
+            kept.insert(kept.end(), lines.begin() + end, lines.end());
+
+            if (kept.size() < lines.size() &&
+                compare(fuzzed.day, join(kept), opts).disagrees()) {
+                lines = kept;
+                removed = true;
+            } else {
+                at += run;
+            }
+        }
+        if (!removed) run /= 2;
+    }
+    return join(lines);
+}
+
+/**
+ * Output
+ */
+void printOutcome(const char* name, const outcome& result) {
+    std::cout << "  " << name;
+    if (result.ok)
+        std::cout << "part 1 " << result.answers[0] << ", part 2 "
+                  << result.answers[1] << "\n";
+    else
+        std::cout << result.failure << "\n";
+}
+
+void report(const target& fuzzed, int64_t scale, uint64_t seed,
+            const std::string& input, const trial& result,
+            const options& opts) {
+    std::string name = dayName(fuzzed.day);
+    std::cout << name << ": fast path disagrees with the reference\n";
+    printOutcome("reference  ", result.reference);
+    printOutcome("fast path  ", result.fast);
+    std::cout << "  from       gen " << fuzzed.day << " --scale " << scale
+              << " --seed " << seed << "\n";
+
+    if (::mkdir(opts.out.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cout << "  Couldn't create " << opts.out << ", the input is:\n"
+                  << input;
+        return;
+    }
+    std::string path = opts.out + "/" + name + "-mismatch.txt";
+    std::ofstream file(path);
+    file << input;
+    if (!file) {
+        std::cout << "  Couldn't write " << path << ", the input is:\n"
+                  << input;
+        return;
+    }
+    std::cout << "  shrunk to  " << path << "\n";
+}
+
+std::string dayName(int day) {
+    std::string name = "day";
+    if (day < 10) name += "0";
+    return name + std::to_string(day);
+}
+
+/**
+ * Options
+ */
+bool parseDays(const char* list, std::vector<int>& days) {
+    days.clear();
+    const char* at = list;
+    while (*at != '\0') {
+        char* end = nullptr;
+        long day = std::strtol(at, &end, 10);
+        if (end == at || findTarget(day) == nullptr) return false;
+        days.push_back(static_cast<int>(day));
+
+        at = end;
+        if (*at == ',') at++;
+        else if (*at != '\0')
+            return false;
+    }
+    return !days.empty();
+}
+
+bool parseOptions(int argc, char** argv, options& opts) {
+    for (const target& fuzzed : targets) opts.days.push_back(fuzzed.day);
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cout << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--days") {
+            if (!parseDays(value, opts.days)) {
+                std::cout << "Bad day list (days with a fast path to check "
+                             "are 5, 6, 10 and 11): "
+                          << value << "\n";
+                return false;
+            }
+        } else if (arg == "--runs") {
+            opts.runs = std::atoi(value);
+            if (opts.runs < 1) {
+                std::cout << "Need at least one run\n";
+                return false;
+            }
+        } else if (arg == "--seed") {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--max-scale") {
+            opts.maxScale = std::atoll(value);
+            if (opts.maxScale < 1) {
+                std::cout << "Scale must be at least 1\n";
+                return false;
+            }
+        } else if (arg == "--timeout") {
+            opts.timeout = std::atoi(value);
+            if (opts.timeout < 1) {
+                std::cout << "Timeout must be at least a second\n";
+                return false;
+            }
+        } else if (arg == "--out") {
+            opts.out = value;
+        } else {
+            std::cout << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
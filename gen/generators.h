@@ -0,0 +1,491 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * The synthetic input generators, one per day, shared by gen/ and fuzz/.
+ * The generators are plain functions, so only one file of a program may
+ * include this.
+ *
+ * generators[day - 1].write(out, scale, rng) writes a valid input for that
+ * day; what the scale counts is different for every day, see each one.
+ */
+
+/**
+ * std::mt19937_64 produces the same sequence everywhere, but the standard
+ * distributions don't, so ranges are cut out of the raw output by hand
+ */
+using randomEngine = std::mt19937_64;
+
+int64_t between(randomEngine& rng, int64_t low, int64_t high) {
+    uint64_t span = static_cast<uint64_t>(high - low) + 1;
+    return low + static_cast<int64_t>(rng() % span);
+}
+
+bool chance(randomEngine& rng, int percent) {
+    return between(rng, 1, 100) <= percent;
+}
+
+template <typename T>
+void shuffle(randomEngine& rng, std::vector<T>& items) {
+    for (size_t i = items.size(); i > 1; i--)
+        std::swap(items[i - 1], items[between(rng, 0, i - 1)]);
+}
+
+std::string padded(int64_t value, size_t width) {
+    std::string text = std::to_string(value);
+    if (text.size() < width) text.insert(0, width - text.size(), ' ');
+    return text;
+}
+
+/**
+ * Day 1: scale is the number of lines
+ */
+void generateDay01(std::ostream& out, int64_t scale, randomEngine& rng) {
+    static const char* words[] = {"one", "two",   "three", "four", "five",
+                                  "six", "seven", "eight", "nine"};
+
+    std::string line;
+    for (int64_t i = 0; i < scale; i++) {
+        line.clear();
+        int64_t length = between(rng, 4, 40);
+        bool hasDigit = false;
+        while (static_cast<int64_t>(line.size()) < length) {
+            int64_t pick = between(rng, 0, 9);
+            if (pick < 2) {
+                line += static_cast<char>('1' + between(rng, 0, 8));
+                hasDigit = true;
+            } else if (pick < 4) {
+                line += words[between(rng, 0, 8)];
+            } else {
+                line += static_cast<char>('a' + between(rng, 0, 25));
+            }
+        }
+        // part 1 needs at least one real digit on every line
+        if (!hasDigit)
+            line.insert(between(rng, 0, line.size()), 1,
+                        static_cast<char>('1' + between(rng, 0, 8)));
+        out << line << "\n";
+    }
+}
+
+/**
+ * Day 2: scale is the number of games
+ */
+void generateDay02(std::ostream& out, int64_t scale, randomEngine& rng) {
+    static const char* colours[] = {"red", "green", "blue"};
+
+    for (int64_t id = 1; id <= scale; id++) {
+        out << "Game " << id << ":";
+        int64_t sets = between(rng, 1, 6);
+        for (int64_t set = 0; set < sets; set++) {
+            std::vector<int> order = {0, 1, 2};
+            shuffle(rng, order);
+            int64_t shown = between(rng, 1, 3);
+            for (int64_t c = 0; c < shown; c++) {
+                out << (c == 0 ? " " : ", ") << between(rng, 1, 20) << " "
+                    << colours[order[c]];
+            }
+            out << (set + 1 < sets ? ";" : "");
+        }
+        out << "\n";
+    }
+}
+
+/**
+ * Day 3: scale is the side of the square schematic
+ */
+void generateDay03(std::ostream& out, int64_t scale, randomEngine& rng) {
+    static const char symbols[] = "*#+$/@%=&-";
+
+    std::string row;
+    for (int64_t r = 0; r < scale; r++) {
+        row.assign(scale, '.');
+        int64_t c = 0;
+        while (c < scale) {
+            int64_t pick = between(rng, 0, 99);
+            int64_t digits = between(rng, 1, 3);
+            if (pick < 9 && c + digits <= scale) {
+                row[c] = static_cast<char>('1' + between(rng, 0, 8));
+                for (int64_t d = 1; d < digits; d++)
+                    row[c + d] = static_cast<char>('0' + between(rng, 0, 9));
+                // leave a gap so two numbers never run together
+                c += digits + 1;
+            } else {
+                if (pick >= 9 && pick < 13)
+                    row[c] = symbols[between(rng, 0, sizeof(symbols) - 2)];
+                c++;
+            }
+        }
+        out << row << "\n";
+    }
+}
+
+/**
+ * Day 4: scale is the number of cards. Wins are kept rare enough that the
+ * number of copies in part 2 stays bounded as the card count grows.
+ */
+void generateDay04(std::ostream& out, int64_t scale, randomEngine& rng) {
+    size_t width = std::to_string(scale).size();
+    if (width < 3) width = 3;
+
+    std::vector<int64_t> pool;
+    for (int64_t n = 1; n <= 99; n++) pool.push_back(n);
+
+    for (int64_t card = 1; card <= scale; card++) {
+        int64_t pick = between(rng, 0, 99);
+        int64_t matches = 0;
+        if (pick >= 60 && pick < 95) matches = between(rng, 1, 2);
+        else if (pick >= 95)
+            matches = between(rng, 3, 10);
+        matches = std::min(matches, scale - card);
+
+        // the first 10 are winning, the next 25 are on the card; the first
+        // few scratch numbers are copies of winning ones to make the matches
+        shuffle(rng, pool);
+        std::vector<int64_t> scratch(pool.begin() + 10, pool.begin() + 35);
+        for (int64_t m = 0; m < matches; m++) scratch[m] = pool[m];
+        shuffle(rng, scratch);
+
+        out << "Card " << padded(card, width) << ":";
+        for (int i = 0; i < 10; i++) out << " " << padded(pool[i], 2);
+        out << " |";
+        for (int64_t number : scratch) out << " " << padded(number, 2);
+        out << "\n";
+    }
+}
+
+/**
+ * Day 5: scale is the number of ranges in each of the seven maps
+ */
+void generateDay05(std::ostream& out, int64_t scale, randomEngine& rng) {
+    static const char* maps[] = {
+        "seed-to-soil",         "soil-to-fertilizer",
+        "fertilizer-to-water",  "water-to-light",
+        "light-to-temperature", "temperature-to-humidity",
+        "humidity-to-location"};
+    const int64_t limit = (int64_t(1) << 32) - 1;
+
+    out << "seeds:";
+    for (int i = 0; i < 10; i++) {
+        int64_t length = between(rng, 1, limit / 20);
+        out << " " << between(rng, 0, limit - length) << " " << length;
+    }
+    out << "\n";
+
+    for (const char* name : maps) {
+        out << "\n" << name << " map:\n";
+
+        // cut [0, limit] into scale source ranges that don't overlap
+        std::vector<int64_t> cuts = {0, limit + 1};
+        for (int64_t i = 1; i < scale; i++)
+            cuts.push_back(between(rng, 1, limit));
+        std::sort(cuts.begin(), cuts.end());
+        cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+        std::vector<std::pair<int64_t, int64_t>> ranges;
+        for (size_t i = 0; i + 1 < cuts.size(); i++)
+            ranges.push_back({cuts[i], cuts[i + 1] - cuts[i]});
+        shuffle(rng, ranges);
+
+        for (const auto& [source, length] : ranges) {
+            // leave some of the space unmapped, like the real input
+            if (chance(rng, 10)) continue;
+            out << between(rng, 0, limit + 1 - length) << " " << source << " "
+                << length << "\n";
+        }
+    }
+}
+
+/**
+ * Day 6: scale is the number of digits in part 2's joined race time, which
+ * sets how long it takes. At most 9, so the joined distance fits in 64 bits.
+ */
+void generateDay06(std::ostream& out, int64_t scale, randomEngine& rng) {
+    int64_t digits = std::max<int64_t>(1, std::min<int64_t>(scale, 9));
+    int64_t races = std::min<int64_t>(digits, 4);
+
+    std::vector<int64_t> times, distances;
+    for (int64_t race = 0; race < races; race++) {
+        int64_t width = digits / races + (race < digits % races ? 1 : 0);
+
+        int64_t low = 1;
+        for (int64_t d = 1; d < width; d++) low *= 10;
+        int64_t time = between(rng, std::max<int64_t>(low, 2), low * 10 - 1);
+
+        // the record is what holding for some time gets, so it can be beaten
+        int64_t hold = between(rng, 1, time / 2);
+        times.push_back(time);
+        distances.push_back(hold * (time - hold) - 1);
+    }
+
+    size_t width = 0;
+    for (int64_t distance : distances)
+        width = std::max(width, std::to_string(distance).size());
+
+    out << "Time:    ";
+    for (int64_t time : times) out << " " << padded(time, width);
+    out << "\nDistance:";
+    for (int64_t distance : distances) out << " " << padded(distance, width);
+    out << "\n";
+}
+
+/**
+ * Day 7: scale is the number of hands
+ */
+void generateDay07(std::ostream& out, int64_t scale, randomEngine& rng) {
+    static const char cards[] = "23456789TJQKA";
+
+    std::string hand(5, ' ');
+    for (int64_t i = 0; i < scale; i++) {
+        for (char& card : hand) card = cards[between(rng, 0, 12)];
+        out << hand << " " << between(rng, 1, 1000) << "\n";
+    }
+}
+
+/**
+ * Day 8: scale is the length of the directions. Node names are three
+ * letters, so the network itself can't grow past a few thousand nodes; each
+ * of the six ghosts walks its own chain of a distinct prime length to its
+ * Z node, and the side not taken at every step leads somewhere random.
+ */
+void generateDay08(std::ostream& out, int64_t scale, randomEngine& rng) {
+    const int ghosts = 6;
+
+    std::string directions(scale, 'L');
+    for (char& direction : directions)
+        if (chance(rng, 50)) direction = 'R';
+    out << directions << "\n\n";
+
+    // names for the chains, never ending in A or Z
+    std::vector<std::string> names;
+    for (char a = 'A'; a <= 'Z'; a++)
+        for (char b = 'A'; b <= 'Z'; b++)
+            for (char c = 'B'; c <= 'Y'; c++) names.push_back({a, b, c});
+    shuffle(rng, names);
+
+    std::vector<std::string> prefixes;
+    for (char a = 'A'; a <= 'Z'; a++)
+        for (char b = 'A'; b <= 'Z'; b++)
+            if (std::string {a, b} != "AA" && std::string {a, b} != "ZZ")
+                prefixes.push_back({a, b});
+    shuffle(rng, prefixes);
+
+    std::vector<int64_t> primes;
+    for (int64_t n = 300; n < 700; n++) {
+        bool prime = true;
+        for (int64_t d = 2; d * d <= n && prime; d++) prime = n % d != 0;
+        if (prime) primes.push_back(n);
+    }
+    shuffle(rng, primes);
+
+    struct node {
+        std::string name, left, right;
+    };
+    std::vector<node> network;
+    size_t nextName = 0;
+
+    for (int g = 0; g < ghosts; g++) {
+        std::string start = g == 0 ? "AAA" : prefixes[g] + "A";
+        std::string end = g == 0 ? "ZZZ" : prefixes[g] + "Z";
+
+        std::vector<std::string> chain = {start};
+        for (int64_t step = 1; step < primes[g]; step++)
+            chain.push_back(names[nextName++]);
+        chain.push_back(end);
+
+        size_t first = network.size();
+        for (size_t step = 0; step + 1 < chain.size(); step++) {
+            std::string taken = chain[step + 1];
+            std::string other = names[between(rng, 0, nextName - 1)];
+            if (directions[step % directions.size()] == 'L')
+                network.push_back({chain[step], taken, other});
+            else
+                network.push_back({chain[step], other, taken});
+        }
+        // the Z node loops back round the way the start leaves
+        network.push_back({end, network[first].left, network[first].right});
+    }
+
+    shuffle(rng, network);
+    for (const auto& n : network)
+        out << n.name << " = (" << n.left << ", " << n.right << ")\n";
+}
+
+/**
+ * Day 9: scale is the number of histories. Each is a polynomial sampled at
+ * 21 points, so repeated differences always reach zero.
+ */
+void generateDay09(std::ostream& out, int64_t scale, randomEngine& rng) {
+    for (int64_t i = 0; i < scale; i++) {
+        // sum of c_k * (x choose k)
+        int64_t degree = between(rng, 1, 12);
+        std::vector<int64_t> coefficients(degree + 1);
+        for (int64_t& c : coefficients) c = between(rng, -20, 20);
+
+        for (int64_t x = 0; x <= 20; x++) {
+            int64_t value = 0;
+            int64_t choose = 1;
+            for (int64_t k = 0; k <= degree && k <= x; k++) {
+                value += coefficients[k] * choose;
+                choose = choose * (x - k) / (k + 1);
+            }
+            out << (x == 0 ? "" : " ") << value;
+        }
+        out << "\n";
+    }
+}
+
+/**
+ * Day 10: scale is the side of the square maze. The loop is the outline of
+ * a random blob of 2x2 blocks, grown so that no two blocks only touch at a
+ * corner, which keeps the outline a single simple path. Everything off the
+ * loop is junk pipe.
+ */
+void generateDay10(std::ostream& out, int64_t scale, randomEngine& rng) {
+    int64_t side = std::max<int64_t>(scale, 5);
+    int64_t blocks = (side - 1) / 2;
+
+    std::vector<std::vector<bool>> blob(blocks, std::vector<bool>(blocks));
+    auto filled = [&](int64_t r, int64_t c) {
+        return r >= 0 && c >= 0 && r < blocks && c < blocks && blob[r][c];
+    };
+    // would filling (r, c) leave it touching a block only at a corner
+    auto pinches = [&](int64_t r, int64_t c) {
+        for (int64_t dr : {-1, 1})
+            for (int64_t dc : {-1, 1})
+                if (filled(r + dr, c + dc) && !filled(r + dr, c) &&
+                    !filled(r, c + dc))
+                    return true;
+        return false;
+    };
+
+    std::vector<std::pair<int64_t, int64_t>> frontier = {
+        {blocks / 2, blocks / 2}};
+    int64_t target = blocks * blocks * 2 / 5 + 1;
+    int64_t count = 0;
+    while (count < target && !frontier.empty()) {
+        // mostly grow from the newest block, which makes long tendrils and
+        // so a long, winding loop
+        size_t pick = chance(rng, 80) ? frontier.size() - 1
+                                      : between(rng, 0, frontier.size() - 1);
+        auto [r, c] = frontier[pick];
+        frontier[pick] = frontier.back();
+        frontier.pop_back();
+
+        if (filled(r, c) || pinches(r, c)) continue;
+        blob[r][c] = true;
+        count++;
+
+        const int64_t steps[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        for (const auto& step : steps) {
+            int64_t nr = r + step[0], nc = c + step[1];
+            if (nr >= 0 && nc >= 0 && nr < blocks && nc < blocks &&
+                !blob[nr][nc])
+                frontier.push_back({nr, nc});
+        }
+    }
+
+    // walk the block corners; corner (i, j) sits at maze cell (2i, 2j)
+    std::vector<std::string> maze(side, std::string(side, ' '));
+    for (int64_t i = 0; i <= blocks; i++) {
+        for (int64_t j = 0; j <= blocks; j++) {
+            bool north = i > 0 && filled(i - 1, j - 1) != filled(i - 1, j);
+            bool south = i < blocks && filled(i, j - 1) != filled(i, j);
+            bool west = j > 0 && filled(i - 1, j - 1) != filled(i, j - 1);
+            bool east = j < blocks && filled(i - 1, j) != filled(i, j);
+
+            char corner = ' ';
+            if (north && south) corner = '|';
+            else if (east && west)
+                corner = '-';
+            else if (north && east)
+                corner = 'L';
+            else if (north && west)
+                corner = 'J';
+            else if (south && west)
+                corner = '7';
+            else if (south && east)
+                corner = 'F';
+
+            if (corner != ' ') maze[2 * i][2 * j] = corner;
+            if (east) maze[2 * i][2 * j + 1] = '-';
+            if (south) maze[2 * i + 1][2 * j] = '|';
+        }
+    }
+
+    // holes in the blob have outlines too; the outer one goes through the
+    // first corner in reading order, an F, so S goes there. The reference's
+    // rays never count S as part of the loop, and only here does that change
+    // nothing: nothing left of it is inside, and the rays from it and from
+    // the cells before it cross the top row's runs an even number of times
+    // either way.
+    int64_t sr = 0, sc = 0;
+    while (maze[sr][sc] != 'F') {
+        sc += 2;
+        if (sc > 2 * blocks) sc = 0, sr += 2;
+    }
+
+    static const char junk[] = "|-LJ7F...";
+    for (auto& row : maze)
+        for (char& cell : row)
+            if (cell == ' ') cell = junk[between(rng, 0, sizeof(junk) - 2)];
+
+    // exactly two neighbours of S may lead into it
+    char shape = maze[sr][sc];
+    maze[sr][sc] = 'S';
+    auto opens = [](const char* pipes, char pipe) {
+        return std::string(pipes).find(pipe) != std::string::npos;
+    };
+    auto clear = [&](int64_t r, int64_t c, const char* into) {
+        if (r < 0 || c < 0 || r >= side || c >= side) return;
+        if (opens(into, maze[r][c])) maze[r][c] = '.';
+    };
+    if (!opens("|LJ", shape)) clear(sr - 1, sc, "|7F");
+    if (!opens("|7F", shape)) clear(sr + 1, sc, "|LJ");
+    if (!opens("-J7", shape)) clear(sr, sc - 1, "-LF");
+    if (!opens("-LF", shape)) clear(sr, sc + 1, "-J7");
+
+    for (const auto& row : maze) out << row << "\n";
+}
+
+/**
+ * Day 11: scale is the side of the square image. About one row and column
+ * in ten is left empty so there is always something to expand.
+ */
+void generateDay11(std::ostream& out, int64_t scale, randomEngine& rng) {
+    std::vector<bool> emptyRow(scale), emptyColumn(scale);
+    for (int64_t i = 0; i < scale; i++) {
+        emptyRow[i] = chance(rng, 10);
+        emptyColumn[i] = chance(rng, 10);
+    }
+
+    std::string row;
+    for (int64_t r = 0; r < scale; r++) {
+        row.assign(scale, '.');
+        if (!emptyRow[r])
+            for (int64_t c = 0; c < scale; c++)
+                if (!emptyColumn[c] && chance(rng, 2)) row[c] = '#';
+        out << row << "\n";
+    }
+}
+
+struct generator {
+    void (*write)(std::ostream&, int64_t, randomEngine&);
+    int64_t defaultScale;
+};
+
+/**
+ * Default scales are roughly the size of the real input
+ */
+const generator generators[] = {
+    {generateDay01, 1000}, {generateDay02, 100}, {generateDay03, 140},
+    {generateDay04, 200},  {generateDay05, 30},  {generateDay06, 8},
+    {generateDay07, 1000}, {generateDay08, 281}, {generateDay09, 200},
+    {generateDay10, 140},  {generateDay11, 140}};
@@ -0,0 +1,59 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "generators.h"
+
+/**
+ * Synthetic input generator
+ *
+ * Writes a valid puzzle input for one day to stdout, at any scale. The same
+ * day, scale and seed always give the same bytes, so timings taken on a
+ * generated input can be reproduced from the command line alone.
+ *
+ *     main <day> [--scale N] [--seed N]
+ *
+ * What the scale counts is different for every day, see generators.h.
+ */
+
+/**
+ * main function
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Usage: main <day> [--scale N] [--seed N]\n";
+        return 1;
+    }
+
+    int day = std::atoi(argv[1]);
+    int days = sizeof(generators) / sizeof(generators[0]);
+    if (day < 1 || day > days) {
+        std::cout << "No generator for day " << argv[1] << "\n";
+        return 1;
+    }
+    const generator& gen = generators[day - 1];
+
+    int64_t scale = gen.defaultScale;
+    uint64_t seed = 1;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--scale") {
+            scale = std::atoll(argv[i + 1]);
+        } else if (arg == "--seed") {
+            seed = std::strtoull(argv[i + 1], nullptr, 10);
+        } else {
+            std::cout << "Unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+    if (scale < 1) {
+        std::cout << "Scale must be at least 1\n";
+        return 1;
+    }
+
+    std::ios::sync_with_stdio(false);
+    randomEngine rng(seed);
+    gen.write(std::cout, scale, rng);
+    return 0;
+}
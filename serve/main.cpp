@@ -0,0 +1,269 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../common/bench.h"
+#include "../common/days.h"
+#include "../common/instrument_heap.h"
+#include "../common/runner.h"
+#include "../common/socket.h"
+
+/**
+ * Solver daemon
+ *
+ * Keeps every day's solver loaded and answers (day, part, input) requests
+ * on one Unix socket, so interactive callers pay for a socket round trip
+ * instead of a process launch. Every day is linked in (common/days.h) and
+ * solved in this process, on the thread of the connection that asked.
+ *
+ *     main --socket PATH [--days 1,7,11]
+ *     main --socket PATH --ask DAY --input FILE [--part 1|2] [--inline]
+ *          [--repeat N]
+ *
+ * The first form runs the daemon. The second is a client: it sends FILE,
+ * by path or inline, prints the answers and the solver's own timings, and
+ * with --repeat sends it N times and reports round-trip latency. See
+ * common/socket.h for the request format.
+ */
+
+struct options {
+    std::string socket;
+    std::vector<int> days;
+    // client mode
+    int ask = 0;
+    std::string input;
+    int part = 0;
+    bool sendInline = false;
+    int repeat = 1;
+};
+
+/**
+ * declarations
+ */
+bool parseOptions(int argc, char** argv, options& opts);
+int runDaemon(const options& opts);
+int runClient(const options& opts);
+
+/**
+ * main function
+ */
+int main(int argc, char** argv) {
+    options opts;
+    if (!parseOptions(argc, argv, opts)) return 1;
+    return opts.ask != 0 ? runClient(opts) : runDaemon(opts);
+}
+
+/**
+ * Options
+ */
+bool parseDays(const char* list, std::vector<int>& days) {
+    days.clear();
+    const char* at = list;
+    while (*at != '\0') {
+        char* end = nullptr;
+        long day = std::strtol(at, &end, 10);
+        if (end == at || day < 1 || day > 25) return false;
+        days.push_back(static_cast<int>(day));
+
+        at = end;
+        if (*at == ',') at++;
+        else if (*at != '\0')
+            return false;
+    }
+    return !days.empty();
+}
+
+bool parseOptions(int argc, char** argv, options& opts) {
+    for (int day = 1; day <= 11; day++) opts.days.push_back(day);
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--inline") {
+            opts.sendInline = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            std::cout << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--socket") {
+            opts.socket = value;
+        } else if (arg == "--days") {
+            if (!parseDays(value, opts.days)) {
+                std::cout << "Bad day list: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--ask") {
+            opts.ask = std::atoi(value);
+            if (opts.ask < 1 || opts.ask > 25) {
+                std::cout << "Day must be 1 to 25\n";
+                return false;
+            }
+        } else if (arg == "--input") {
+            opts.input = value;
+        } else if (arg == "--part") {
+            opts.part = std::atoi(value);
+            if (opts.part < 1 || opts.part > 2) {
+                std::cout << "Part must be 1 or 2\n";
+                return false;
+            }
+        } else if (arg == "--repeat") {
+            opts.repeat = std::atoi(value);
+            if (opts.repeat < 1) {
+                std::cout << "Need at least one request\n";
+                return false;
+            }
+        } else {
+            std::cout << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+
+    if (opts.socket.empty()) {
+        std::cout << "No --socket given\n";
+        return false;
+    }
+    if (opts.ask != 0 && opts.input.empty()) {
+        std::cout << "No --input given\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Daemon
+ */
+
+/**
+ * Read one request from a client and answer it with the day it names.
+ * Returns false once the client has gone away.
+ */
+bool answer(int client, aoc::SocketReader& reader,
+            aoc::Connection& connection, const std::vector<int>& days) {
+    std::string header;
+    if (!reader.readLine(header)) return false;
+
+    std::istringstream fields(header);
+    int day = 0;
+    fields >> day;
+    const aoc::Solver* solver = nullptr;
+    if (std::find(days.begin(), days.end(), day) != days.end())
+        solver = aoc::findSolver(day);
+
+    return aoc::answerRequest(client, reader, fields, solver, connection);
+}
+
+int runDaemon(const options& opts) {
+    int serving = 0;
+    for (int day : opts.days) serving += aoc::findSolver(day) != nullptr;
+
+    int listener = aoc::listenUnix(opts.socket);
+    if (listener < 0) {
+        std::cout << "Couldn't listen on " << opts.socket << ": "
+                  << std::strerror(errno) << "\n";
+        return 1;
+    }
+    std::cout << "Serving " << serving << " days on " << opts.socket << "\n"
+              << std::flush;
+
+    while (true) {
+        int client = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            std::cout << "Couldn't accept: " << std::strerror(errno) << "\n";
+            return 1;
+        }
+
+        std::thread([client, &opts] {
+            aoc::SocketReader reader(client);
+            aoc::Connection connection;
+            while (answer(client, reader, connection, opts.days))
+                ;
+            ::close(client);
+        }).detach();
+    }
+}
+
+/**
+ * Client
+ */
+int runClient(const options& opts) {
+    std::string request = std::to_string(opts.ask) + " " +
+                          std::to_string(opts.part) + " ";
+    std::string payload;
+    if (opts.sendInline) {
+        std::ifstream file(opts.input, std::ios::binary);
+        if (!file) {
+            std::cout << "Coudn't find input file\n";
+            return 1;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        payload = contents.str();
+        request += "inline " + std::to_string(payload.size()) + "\n";
+    } else {
+        request += "path " + opts.input + "\n";
+    }
+
+    int fd = aoc::connectUnix(opts.socket);
+    if (fd < 0) {
+        std::cout << "Couldn't connect to " << opts.socket << ": "
+                  << std::strerror(errno) << "\n";
+        return 1;
+    }
+    aoc::SocketReader reader(fd);
+
+    aoc::Samples roundTrips;
+    std::string reply;
+    std::string answers;
+    for (int i = 0; i < opts.repeat; i++) {
+        aoc::Clock::time_point start = aoc::Clock::now();
+        if (!aoc::sendAll(fd, request) || !aoc::sendAll(fd, payload) ||
+            !reader.readLine(reply)) {
+            std::cout << "Lost the connection\n";
+            return 1;
+        }
+        if (reply.compare(0, 3, "ok ") != 0) {
+            std::cout << reply << "\n";
+            return 1;
+        }
+
+        std::istringstream fields(reply.substr(3));
+        int64_t parseNs, part1Ns, part2Ns;
+        size_t length;
+        fields >> parseNs >> part1Ns >> part2Ns >> length;
+        if (!reader.read(answers, length)) {
+            std::cout << "Lost the connection\n";
+            return 1;
+        }
+        roundTrips.push_back(aoc::elapsedNs(start, aoc::Clock::now()));
+
+        if (i == 0) {
+            std::cout << answers << "parse " << parseNs << " ns, part1 "
+                      << part1Ns << " ns, part2 " << part2Ns << " ns\n";
+        }
+    }
+    ::close(fd);
+
+    if (opts.repeat > 1) {
+        aoc::Stats stats = aoc::summarize(roundTrips);
+        std::cout << std::fixed << std::setprecision(1) << opts.repeat
+                  << " requests, round trip min " << stats.min / 1000.0
+                  << " us, median " << stats.median / 1000.0 << " us, p99 "
+                  << stats.p99 / 1000.0 << " us\n";
+    }
+    return 0;
+}
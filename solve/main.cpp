@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "../common/days.h"
+#include "../common/instrument_heap.h"
+#include "../common/runner.h"
+
+/**
+ * Every day in one binary
+ *
+ * Takes a day's number followed by that day's own command line (see
+ * common/runner.h), or solves a batch whose files may belong to any day:
+ *
+ *     main <day> <input file> [options]
+ *     main --batch [<file or glob>...] [--manifest <file>] [--jobs N]
+ *                  [--part 1|2] [--cache]
+ *
+ * In a batch each file is solved by the day named in its path, the first
+ * "dayNN" in it, so dayNN/input.txt and build/synthetic/dayNN.txt both
+ * work. Answers are grouped under "== <file>" headers, as a day's own
+ * --batch prints them.
+ */
+
+/**
+ * declarations
+ */
+int runBatch(int argc, char** argv);
+
+/**
+ * main function
+ */
+int main(int argc, char** argv) {
+    if (argc >= 2 && std::strcmp(argv[1], "--batch") == 0)
+        return runBatch(argc, argv);
+
+    char* end = nullptr;
+    long day = argc >= 2 ? std::strtol(argv[1], &end, 10) : 0;
+    const aoc::Solver* solver =
+        end != nullptr && *end == '\0' ? aoc::findSolver(day) : nullptr;
+    if (solver == nullptr) {
+        std::cout << "Usage: " << argv[0] << " <day> <input file> [options]\n"
+                  << "       " << argv[0] << " --batch <files>...\n";
+        return 1;
+    }
+
+    // the day's options start where its own argv[0] would be
+    return aoc::run(argc - 1, argv + 1, *solver);
+}
+
+/**
+ * Batch
+ */
+int runBatch(int argc, char** argv) {
+    aoc::Options options;
+    if (!aoc::parseOptions(argc, argv, options)) return 1;
+    aoc::setReduceJobs(options.jobs);
+
+    int status = 1;
+    try {
+        status = aoc::batch(options, aoc::solverForPath);
+    } catch (const aoc::InputError& error) {
+        std::cout << error.what() << "\n";
+    }
+    if (!aoc::writeStats(options)) return 1;
+    return status;
+}
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input.h"
+#include "../common/runner.h"
+#include "../common/solver.h"
+#include "../common/tokenize.h"
+#include "day.h"
+
+// rename to the day, here and in day.h and main.cpp, then add the day to
+// common/days.h
+namespace dayNN {
+
+/**
+ * Parsed puzzle input, built once and shared by both parts
+ */
+struct puzzle {
+    std::vector<std::string_view> lines;
+};
+
+/**
+ * declarations
+ */
+puzzle parse(const aoc::Input& input);
+
+aoc::Answer part1(const puzzle& parsed);
+
+aoc::Answer part2(const puzzle& parsed);
+
+/**
+ * main function
+ */
+const auto daySolver = aoc::makeSolver(parse, part1, part2);
+
+const aoc::Solver& solver() { return daySolver; }
+
+/**
+ * Parsing
+ */
+puzzle parse(const aoc::Input& input) {
+    aoc::Lines lines = input.lines();
+    puzzle parsed;
+
+    std::string_view line;
+    aoc::Tokens tokens;
+    while (lines.next(line)) {
+        aoc::tokenize(line, tokens);
+        parsed.lines.push_back(line);
+    }
+
+    return parsed;
+}
+
+/**
+ * Part 1
+ */
+aoc::Answer part1(const puzzle& parsed) {
+    long answer = 0;
+    for (std::string_view line : parsed.lines) {}
+
+    return {"Part 1: ", answer};
+}
+
+/**
+ * Part 2
+ */
+aoc::Answer part2(const puzzle& parsed) {
+    long answer = 0;
+    for (std::string_view line : parsed.lines) {}
+
+    return {"Part 2: ", answer};
+}
+
+}  // namespace dayNN
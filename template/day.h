@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../common/solver.h"
+
+/**
+ * Day NN: Title
+ */
+namespace dayNN {
+    const aoc::Solver& solver();
+}  // namespace dayNN